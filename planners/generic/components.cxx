@@ -1,10 +1,21 @@
 
+#include <stdexcept>
+
 #include "components.hxx"
 #include <utils/loader.hxx>
 #include <utils/component_factory.hxx>
 
 fs0::Problem* generate(const rapidjson::Document& data, const std::string& data_dir) {
+	// Externally-defined symbols (those prefixed by '@') can only be implemented by the instance-specific plugin
+	const rapidjson::Value& symbols = data["symbols"];
+	for (unsigned i = 0; i < symbols.Size(); ++i) {
+		std::string name = symbols[i][1].GetString();
+		if (!name.empty() && name[0] == '@') {
+			throw std::runtime_error("The problem has externally-defined symbol '" + name + "' and needs to be run with the plugin (--plugin) compiled for it");
+		}
+	}
+	
 	fs0::BaseComponentFactory factory;
 	fs0::Loader::loadProblemInfo(data, data_dir, factory);
 	return fs0::Loader::loadProblem(data, nullptr);
-}
\ No newline at end of file
+}
@@ -6,8 +6,9 @@
 #include <components.hxx>  
 
 
-// Our main function simply creates a runner with the command-line options plus the generator function
-// which is specific to a single problem instance, and then runs the search engine
+// Our main function simply creates a runner with the command-line options plus the generator function, and then runs
+// the search engine. The generic generator handles any problem without externally-defined symbols; problems with
+// such symbols are generated by the instance-specific plugin given through the '--plugin' option.
 int main(int argc, char** argv) {
 	fs0::drivers::Runner runner(fs0::drivers::EngineOptions(argc, argv), generate);
 	return runner.run();
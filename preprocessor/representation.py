@@ -52,6 +52,7 @@ class ProblemRepresentation(object):
             assert isinstance(elem, DataElement)
             serialized = elem.serialize_data(self.index.objects.data)
             self.dump_data(elem.name, serialized)
+            self.dump_binary_data(elem.name, elem.serialize_binary(self.index.objects.data))
 
     def get_method_factories(self):
         return tplManager.get('factories').substitute(
@@ -117,6 +118,12 @@ class ProblemRepresentation(object):
         with open(self.translation_dir + '/' + name, "w") as f:
             f.write(translation)
 
+    def dump_binary_data(self, name, data):
+        basedir = self.translation_dir + '/data'
+        util.mkdirp(basedir)
+        with open(basedir + '/' + name + '.bin', "wb") as f:
+            f.write(data)
+
     def dump_data(self, name, data, ext='data', subdir=None):
         if not isinstance(data, list):
             data = [data]
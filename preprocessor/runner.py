@@ -31,6 +31,8 @@ def parse_arguments(args):
     parser.add_argument('--debug', action='store_true', help="Flag to compile in debug mode.")
     parser.add_argument('--edebug', action='store_true', help="Flag to compile in extreme debug mode.")
     parser.add_argument('--run', action='store_true', help="Set to run the solver after compiling it.")
+    parser.add_argument('--plugin', default=None, help="A previously compiled plugin with the external symbols to load "
+                                                       "when running the solver, if none is compiled for the instance.")
 
     parser.add_argument("--driver", help='The solver driver file', default=None)
     parser.add_argument("--defaults", help='The solver default options file', default=None)
@@ -93,8 +95,10 @@ def move_files(base_dir, instance, domain, target_dir, use_vanilla):
 
 def compile_translation(translation_dir, use_vanilla, args):
     """
-    Copies the relevant files from the planner directory to the newly-created translation directory,
-     and then calls scons to compile the problem there.
+    Copies the generic solver binary to the newly-created translation directory and, if the problem has
+     externally-defined symbols, calls scons to compile there the plugin that implements them, which
+     the generic solver loads at runtime.
+     Returns the path of the compiled plugin, or None if no plugin was compiled.
     """
     debug_flag = "edebug=1" if args.edebug else ("debug=1" if args.debug else "")
 
@@ -104,29 +108,31 @@ def compile_translation(translation_dir, use_vanilla, args):
     vanilla_solver_name = solver_name(args)
     vanilla_solver_path = os.path.join(planner_dir, vanilla_solver_name)
 
-    if use_vanilla and not os.path.isfile(vanilla_solver_path):
-        raise RuntimeError("The problem could use the vanilla solver binary, but this cannot be found on "
-                           "the expected path. Please re-build the project with the appropriate debug configuration.")
+    if not os.path.isfile(vanilla_solver_path):
+        raise RuntimeError("The generic solver binary cannot be found on the expected path '{}'. Please re-build the "
+                           "project with the appropriate debug configuration.".format(vanilla_solver_path))
 
-    if use_vanilla:
-        print("Using pre-compiled vanilla solver from '{}'".format(vanilla_solver_path))
-        shutil.copy(vanilla_solver_path, translation_dir)
+    print("Using pre-compiled generic solver from '{}'".format(vanilla_solver_path))
+    shutil.copy(vanilla_solver_path, translation_dir)
 
-    else:  # We compile the solver from scratch
-        shutil.copy(os.path.join(planner_dir, 'main.cxx'), translation_dir)
+    if not use_vanilla:  # We compile the instance-specific plugin
         shutil.copy(os.path.join(planner_dir, 'SConstruct'), os.path.join(translation_dir, 'SConstruct'))
 
-        command = "scons {}".format(debug_flag)
+        command = "scons plugin=1 {}".format(debug_flag)
 
         print("{0:<30}{1}\n".format("Compilation command:", command))
         sys.stdout.flush()  # Flush the output to avoid it mixing with the subprocess call.
         output = subprocess.call(command.split(), cwd=translation_dir)
         if output != 0:
             raise RuntimeError('Error compiling problem at {0}'.format(translation_dir))
+        return os.path.join(translation_dir, plugin_name(args))
 
+    return None
 
-def run_solver(translation_dir, args):
-    """ Runs the solver binary resulting from the compilation """
+
+def run_solver(translation_dir, plugin, args):
+    """ Runs the solver binary resulting from the compilation, loading the given plugin, if any.
+     A plugin left over in the translation directory by a previous run is never loaded, as it might be stale. """
     if not args.run:  # Simply return without running anything
         return
 
@@ -138,6 +144,12 @@ def run_solver(translation_dir, args):
 
     command = [solver, "--driver", args.driver]
 
+    plugin = plugin or (os.path.abspath(args.plugin) if args.plugin else None)
+    if plugin:
+        if not os.path.isfile(plugin):
+            raise RuntimeError("The plugin cannot be found on the expected path '{}'".format(plugin))
+        command += ["--plugin", plugin]
+
     if args.defaults:
         command += ["--defaults", args.defaults]
 
@@ -156,6 +168,10 @@ def solver_name(args):
     return "solver.edebug.bin" if args.edebug else ("solver.debug.bin" if args.debug else "solver.bin")
 
 
+def plugin_name(args):
+    return "components.edebug.so" if args.edebug else ("components.debug.so" if args.debug else "components.so")
+
+
 def main(args):
     # Determine the proper domain and instance filenames
     if args.domain is None:
@@ -180,14 +196,14 @@ def main(args):
     fs_task = create_fs_task(fd_task, domain_name, instance_name)
 
     # Generate the appropriate problem representation from our task, store it, and (if necessary) compile
-    # the C++ generated code to obtain a binary tailored to the particular instance
+    # the C++ generated code into a plugin with the external symbols of the particular instance
     representation = ProblemRepresentation(fs_task, translation_dir, args.edebug or args.debug)
     representation.generate()
     use_vanilla = not representation.requires_compilation()
 
     move_files(args.instance_dir, args.instance, args.domain, translation_dir, use_vanilla)
-    compile_translation(translation_dir, use_vanilla, args)
-    run_solver(translation_dir, args)
+    plugin = compile_translation(translation_dir, use_vanilla, args)
+    run_solver(translation_dir, plugin, args)
 
 
 if __name__ == "__main__":
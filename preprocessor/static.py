@@ -2,9 +2,17 @@
     This module contains a number of classes and routines to handle the static (external) data, including its
     declaration and serialization.
 """
+import struct
+import sys
+from array import array
+
 import base
 import util
 
+# The header of the binary data files read by the planner; see Serializer::BinaryHeader
+BINARY_MAGIC = b'FSDB'
+BINARY_VERSION = 1
+
 
 def instantiate_extension(symbol):
     if isinstance(symbol, base.Predicate):
@@ -27,9 +35,12 @@ def instantiate_predicate(name, arity):
     return (classes[arity])(name)
 
 
+def index_symbol(symbol, table):
+    return int(symbol) if util.is_int(symbol) else table[symbol]
+
+
 def serialize_symbol(symbol, table):
-    serialized = symbol if util.is_int(symbol) else table[symbol]
-    return str(serialized)
+    return str(index_symbol(symbol, table))
 
 
 def serialize_tuple(t, symbols):
@@ -38,6 +49,11 @@ def serialize_tuple(t, symbols):
     return ','.join(serialize_symbol(e, symbols) for e in t)
 
 
+def index_tuple(t, symbols):
+    t = (t,) if not isinstance(t, (list, tuple)) else t
+    return tuple(index_symbol(e, symbols) for e in t)
+
+
 class DataElement:
     def __init__(self, name):
         self.name = util.normalize(name)
@@ -45,6 +61,23 @@ class DataElement:
     def serialize_data(self, symbols):
         raise RuntimeError("Method must be subclassed")
 
+    def index_data(self, symbols):
+        """ Return the rows of integers with the extension of the element """
+        raise RuntimeError("Method must be subclassed")
+
+    def row_width(self):
+        raise RuntimeError("Method must be subclassed")
+
+    def serialize_binary(self, symbols):
+        """ Return the binary serialization of the element, with its rows sorted so that the planner
+            can load them without any parsing nor reordering """
+        rows = sorted(set(self.index_data(symbols)))
+        data = array('i', (e for row in rows for e in row))
+        if sys.byteorder != 'little':
+            data.byteswap()
+        header = struct.pack('<4sIIIQ', BINARY_MAGIC, BINARY_VERSION, self.row_width(), 0, len(rows))
+        return header + data.tobytes()
+
 
 class StaticProcedure(object):
     def __init__(self, name):
@@ -63,6 +96,12 @@ class Arity0Element(DataElement):
     def serialize_data(self, symbols):
         return [serialize_symbol(self.elems[()], symbols)]  # We simply print the only element
 
+    def index_data(self, symbols):
+        return [(index_symbol(self.elems[()], symbols),)]
+
+    def row_width(self):
+        return 1
+
 
 class UnaryMap(DataElement):
     ARITY = 1
@@ -78,6 +117,12 @@ class UnaryMap(DataElement):
     def serialize_data(self, symbols):
         return [serialize_tuple(k + (v,), symbols) for k, v in self.elems.items()]
 
+    def index_data(self, symbols):
+        return [index_tuple(k + (v,), symbols) for k, v in self.elems.items()]
+
+    def row_width(self):
+        return self.ARITY + 1
+
     def validate(self, elem, value):
         if len(elem) != self.ARITY:
             raise RuntimeError("Wrong type or number of arguments for data element {}: {}({}) = {}".format(
@@ -111,6 +156,12 @@ class UnarySet(DataElement):
     def serialize_data(self, symbols):
         return [serialize_tuple(elem, symbols) for elem in self.elems]
 
+    def index_data(self, symbols):
+        return [index_tuple(elem, symbols) for elem in self.elems]
+
+    def row_width(self):
+        return self.ARITY
+
     def validate(self, elem):
         if len(elem) != self.ARITY:
             raise RuntimeError("Wrong type or number of arguments for data element {}: {}({})".format(
@@ -131,6 +182,12 @@ class ZeroarySet(UnarySet):
     def serialize_data(self, symbols):
         return [serialize_symbol(self.elems[()], symbols)]  # We simply print the only element
 
+    def index_data(self, symbols):
+        return [(index_symbol(self.elems[()], symbols),)]
+
+    def row_width(self):
+        return 1
+
 
 class BinarySet(UnarySet):
     ARITY = 2
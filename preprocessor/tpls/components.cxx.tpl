@@ -4,10 +4,21 @@
 
 std::unique_ptr<External> external;
 
+namespace {
+
+//! Internal linkage, so that it does not clash with the built-in generator of the planner that loads the plugin
 Problem* generate(const rapidjson::Document& data, const std::string& data_dir) {
 	ComponentFactory factory;
 	const ProblemInfo& info = Loader::loadProblemInfo(data, data_dir, factory);
 	external = std::unique_ptr<External>(new External(info, data_dir));
 	external->registerComponents();
 	return Loader::loadProblem(data, external->get_asp_handler());
-}
\ No newline at end of file
+}
+
+} // namespace
+
+//! The entry point through which the generic planner generates the problem when loading this code as a plugin,
+//! and the only symbol that the plugin exports
+extern "C" __attribute__((visibility("default"))) Problem* fs_generate_problem(const rapidjson::Document& data, const std::string& data_dir) {
+	return generate(data, data_dir);
+}
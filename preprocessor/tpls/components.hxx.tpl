@@ -14,6 +14,3 @@ using namespace fs0;
 extern std::unique_ptr<External> external;
 
 $method_factories
-
-/* Generate the whole planning problem */
-Problem* generate(const rapidjson::Document& data, const std::string& data_dir);
@@ -70,7 +70,11 @@ PartiallyGroundedAction::PartiallyGroundedAction(const ActionData& action_data,
 
 
 GroundAction::GroundAction(unsigned id, const ActionData& action_data, const Binding& binding, const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects) : 
-	ActionBase(action_data, binding, precondition, effects), _id(id)
+	ActionBase(action_data, binding, precondition, effects), _id(id), _compiled_precondition(_precondition)
+{}
+
+GroundAction::GroundAction(const GroundAction& o) :
+	ActionBase(o), _id(o._id), _compiled_precondition(_precondition)
 {}
 
 
@@ -3,6 +3,7 @@
 
 #include <fs_types.hxx>
 #include <utils/binding.hxx>
+#include <languages/fstrips/bytecode.hxx>
 
 
 namespace fs0 { namespace language { namespace fstrips { class Term; class Formula; class ActionEffect; } }}
@@ -12,6 +13,7 @@ namespace fs0 {
 
 class GroundActionIterator;
 class ProblemInfo;
+class State;
 
 //! All the data that fully characterizes a lifted action
 class ActionData {
@@ -110,6 +112,9 @@ class GroundAction : public ActionBase {
 protected:
 	//! The id that identifies the concrete action within the whole set of ground actions
 	unsigned _id;
+	
+	//! The precondition of the action, compiled if possible
+	fs::CompiledFormula _compiled_precondition;
 
 public:
 	//! Trait required by aptk::DetStateModel
@@ -121,7 +126,12 @@ public:
 	GroundAction(unsigned id, const ActionData& action_data, const Binding& binding, const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects);
 	~GroundAction() = default;
 	
+	GroundAction(const GroundAction& o);
+	
 	unsigned getId() const { return _id; }
+	
+	//! Returns true iff the precondition of the action holds in the given state
+	bool precondition_holds(const State& state) const { return _compiled_precondition.interpret(state); }
 };
 
 
@@ -1,24 +1,38 @@
 
 #include <actions/ground_action_iterator.hxx>
+#include <applicability/successor_generator.hxx>
 
 namespace fs0 {
 
-GroundActionIterator::GroundActionIterator(const ApplicabilityManager& actionManager, const State& state, const std::vector<const GroundAction*>& actions) :
-	_actionManager(actionManager), _actions(actions), _state(state)
+GroundActionIterator::GroundActionIterator(const ApplicabilityManager& actionManager, const SuccessorGenerator& generator, const State& state, const std::vector<const GroundAction*>& actions) :
+	_actionManager(actionManager), _generator(generator), _actions(actions), _state(state), _candidates(), _preconditions_hold(false)
+{
+	_generator.generate(_state, _candidates);
+}
+
+GroundActionIterator::GroundActionIterator(const ApplicabilityManager& actionManager, const SuccessorGenerator& generator, const State& state, const std::vector<const GroundAction*>& actions, std::vector<ActionIdx>&& candidates) :
+	_actionManager(actionManager), _generator(generator), _actions(actions), _state(state), _candidates(std::move(candidates)), _preconditions_hold(true)
 {}
 	
-GroundActionIterator::Iterator::Iterator(const State& state, const std::vector<const GroundAction*>& actions, const ApplicabilityManager& actionManager, unsigned currentIdx) :
-	_actionManager(actionManager),
-	_actions(actions),
-	_state(state),
+GroundActionIterator::Iterator::Iterator(const GroundActionIterator& parent, unsigned currentIdx) :
+	_parent(parent),
 	_currentIdx(currentIdx)
 {
 	advance();
 }
 
 void GroundActionIterator::Iterator::advance() {
-	for (;_currentIdx != _actions.size(); ++_currentIdx) {
-		if (_actionManager.isApplicable(_state, *_actions[_currentIdx])) { // The action is applicable, break the for loop.
+	const auto& candidates = _parent._candidates;
+	for (;_currentIdx != candidates.size(); ++_currentIdx) {
+		ActionIdx action = candidates[_currentIdx];
+		const GroundAction& ground = *_parent._actions[action];
+		
+		// If the whole precondition is indexed, we know it holds, and need only check the validity of the effects
+		bool applicable = (_parent._preconditions_hold || _parent._generator.isFullyIndexed(action)) ?
+			_parent._actionManager.checkEffectsAreValid(_parent._state, ground) :
+			_parent._actionManager.isApplicable(_parent._state, ground);
+		
+		if (applicable) { // The action is applicable, break the for loop.
 			break;
 		}
 	}
@@ -7,31 +7,42 @@ namespace fs0 {
 
 class State;
 class GroundAction;
+class SuccessorGenerator;
 
 //! A simple iterator strategy to iterate over the actions applicable in a given state.
+//! The candidate actions are retrieved from the successor generator, and only those whose precondition is not
+//! fully indexed by the generator need to have their precondition checked again.
 class GroundActionIterator {
 protected:
 	const ApplicabilityManager _actionManager;
 	
+	const SuccessorGenerator& _generator;
+	
 	const std::vector<const GroundAction*>& _actions;
 	
 	const State& _state;
 	
+	//! The IDs of the actions whose indexed preconditions hold in the state
+	std::vector<ActionIdx> _candidates;
+	
+	//! Whether the whole preconditions of all candidates are already known to hold in the state
+	bool _preconditions_hold;
+	
 public:
-	GroundActionIterator(const ApplicabilityManager& actionManager, const State& state, const std::vector<const GroundAction*>& actions);
+	GroundActionIterator(const ApplicabilityManager& actionManager, const SuccessorGenerator& generator, const State& state, const std::vector<const GroundAction*>& actions);
+	
+	//! Iterate over the given candidates, all of whose preconditions are known to hold in the state
+	GroundActionIterator(const ApplicabilityManager& actionManager, const SuccessorGenerator& generator, const State& state, const std::vector<const GroundAction*>& actions, std::vector<ActionIdx>&& candidates);
 	
 	class Iterator {
 		friend class GroundActionIterator;
 		
 	protected:
-		Iterator(const State& state, const std::vector<const GroundAction*>& actions, const ApplicabilityManager& actionManager, unsigned currentIdx);
+		Iterator(const GroundActionIterator& parent, unsigned currentIdx);
 
-		const ApplicabilityManager& _actionManager;
-		
-		const std::vector<const GroundAction*>& _actions;
-		
-		const State& _state;
+		const GroundActionIterator& _parent;
 		
+		//! The index of the current action within the list of candidates
 		unsigned _currentIdx;
 		
 		void advance();
@@ -40,14 +51,14 @@ public:
 		const Iterator& operator++();
 		const Iterator operator++(int) {Iterator tmp(*this); operator++(); return tmp;}
 
-		ActionIdx operator*() const { return _currentIdx; }
+		ActionIdx operator*() const { return _parent._candidates[_currentIdx]; }
 		
 		bool operator==(const Iterator &other) const { return _currentIdx == other._currentIdx; }
 		bool operator!=(const Iterator &other) const { return !(this->operator==(other)); }
 	};
 	
-	Iterator begin() const { return Iterator(_state, _actions, _actionManager, 0); }
-	Iterator end() const { return Iterator(_state,_actions, _actionManager, _actions.size() ); }
+	Iterator begin() const { return Iterator(*this, 0); }
+	Iterator end() const { return Iterator(*this, _candidates.size()); }
 };
 
 
@@ -1,6 +1,9 @@
 
 #include <actions/grounding.hxx>
 #include <actions/actions.hxx>
+#include <actions/reachability_grounding.hxx>
+#include <actions/grounding_cache.hxx>
+#include <problem.hxx>
 #include <aptk2/tools/logging.hxx>
 #include <utils/printers/binding.hxx>
 #include <utils/printers/actions.hxx>
@@ -9,6 +12,8 @@
 #include <utils/utils.hxx>
 #include <languages/fstrips/language.hxx>
 #include <unordered_set>
+#include <thread>
+#include <exception>
 
 namespace fs0 {
 
@@ -25,8 +30,47 @@ ActionGrounder::fully_lifted(const std::vector<const ActionData*>& action_data,
 }
 
 
+std::vector<const GroundAction*>
+ActionGrounder::fully_ground(const Problem& problem, const ProblemInfo& info) {
+	const Config& config = Config::instance();
+	if (config.getGroundingCache().empty()) return ground_schemata(problem, info);
+	
+	GroundingCache cache(config.getGroundingCache(), problem.getActionData(), info, config.useReachabilityGrounding());
+	std::vector<GroundingCache::Entry> entries;
+	if (cache.load(entries)) {
+		std::vector<const GroundAction*> grounded;
+		grounded.reserve(entries.size());
+		for (const GroundingCache::Entry& entry:entries) {
+			GroundAction* action = full_binding(grounded.size(), *entry.first, entry.second, info);
+			if (!action) throw std::runtime_error("Cached binding generates a statically non-applicable action; remove the grounding cache " + cache.getFilename());
+			grounded.push_back(action);
+		}
+		std::cout << "Loaded " << grounded.size() << " grounded actions from the grounding cache " << cache.getFilename() << std::endl;
+		return grounded;
+	}
+	
+	std::vector<const GroundAction*> grounded = ground_schemata(problem, info);
+	cache.store(grounded);
+	return grounded;
+}
+
+std::vector<const GroundAction*>
+ActionGrounder::ground_schemata(const Problem& problem, const ProblemInfo& info) {
+	if (!Config::instance().useReachabilityGrounding()) return fully_ground(problem.getActionData(), info);
+	
+	std::cout << "Grounding action schemata by relaxed reachability analysis" << std::endl;
+	return ReachabilityGrounder(problem.getActionData(), problem.getInitialState(), info).ground();
+}
+
 std::vector<const GroundAction*>
 ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info) {
+	return fully_ground(action_data, info, Config::instance().getGroundingThreads());
+}
+
+std::vector<const GroundAction*>
+ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, unsigned num_threads) {
+	if (num_threads == 0) num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	
 	std::vector<const GroundAction*> grounded;
 	unsigned total_num_bindings = 0;
 	
@@ -49,6 +93,15 @@ ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data,
 		std::cout <<  "Grounding action schema '" << print::action_data_name(*data) << "' with " << num_bindings << " possible bindings:\n\t" << std::flush;
 		LPT_INFO("grounding", "Grounding the following action schema with " << num_bindings << " possible bindings:\n" << print::action_data_name(*data) << "\n");
 		
+		// Splitting the work among threads pays off only when there are enough bindings
+		if (num_threads > 1 && static_cast<unsigned>(num_bindings) >= num_threads * MIN_BINDINGS_PER_THREAD) {
+			std::cout << "(using " << num_threads << " threads) " << std::flush;
+			id = ground_in_parallel(id, data, info, num_threads, grounded);
+			total_num_bindings += num_bindings;
+			std::cout << "100%" << std::endl;
+			continue;
+		}
+		
 		float onepercent = ((float)num_bindings / 100);
 		int progress = 0;
 		unsigned i = 0;
@@ -86,6 +139,59 @@ ActionGrounder::ground(unsigned id, const ActionData* data, const Binding& bindi
 	return id;
 }
 
+unsigned
+ActionGrounder::ground_in_parallel(unsigned id, const ActionData* data, const ProblemInfo& info, unsigned num_threads, std::vector<const GroundAction*>& grounded) {
+	// The components of the actions bound by each thread, in the order of their bindings.
+	struct BoundAction {
+		Binding binding;
+		const fs::Formula* precondition;
+		std::vector<const fs::ActionEffect*> effects;
+	};
+	
+	const Signature& signature = data->getSignature();
+	unsigned num_bindings = utils::binding_iterator(signature, info).num_bindings();
+	unsigned chunk_size = (num_bindings + num_threads - 1) / num_threads;
+	
+	std::vector<std::vector<BoundAction>> bound(num_threads);
+	std::vector<std::exception_ptr> errors(num_threads);
+	std::vector<std::thread> workers;
+	
+	// Each thread processes a contiguous chunk of the binding space. Note that bindings are only bound, not turned into
+	// ground actions, since action IDs can only be assigned once the number of actions of all previous chunks is known.
+	for (unsigned t = 0; t < num_threads; ++t) {
+		workers.push_back(std::thread([&, t]() {
+			try {
+				unsigned start = t * chunk_size, end = std::min(num_bindings, start + chunk_size);
+				utils::binding_iterator binding_generator(signature, info);
+				binding_generator.seek(start);
+				
+				for (unsigned i = start; i < end && !binding_generator.ended(); ++i, ++binding_generator) {
+					Binding binding = *binding_generator;
+					BoundAction action{binding, nullptr, {}};
+					if (bind_components(*data, binding, info, action.precondition, action.effects)) {
+						bound[t].push_back(std::move(action));
+					}
+				}
+			} catch (...) {
+				errors[t] = std::current_exception();
+			}
+		}));
+	}
+	
+	for (std::thread& worker:workers) worker.join();
+	for (const std::exception_ptr& error:errors) {
+		if (error) std::rethrow_exception(error);
+	}
+	
+	// Merge the results in order, so that IDs are the same as if the grounding had been sequential
+	for (std::vector<BoundAction>& chunk:bound) {
+		for (BoundAction& action:chunk) {
+			grounded.push_back(new GroundAction(id++, *data, action.binding, action.precondition, action.effects));
+		}
+	}
+	return id;
+}
+
 ActionData*
 ActionGrounder::process_action_data(const ActionData& action_data, const ProblemInfo& info) {
 	Binding binding; // An empty binding
@@ -105,19 +211,27 @@ ActionGrounder::process_action_data(const ActionData& action_data, const Problem
 
 GroundAction*
 ActionGrounder::full_binding(unsigned id, const ActionData& action_data, const Binding& binding, const ProblemInfo& info) {
+	const fs::Formula* precondition = nullptr;
+	std::vector<const fs::ActionEffect*> effects;
+	if (!bind_components(action_data, binding, info, precondition, effects)) return nullptr;
+	return new GroundAction(id, action_data, binding, precondition, effects);
+}
+
+bool
+ActionGrounder::bind_components(const ActionData& action_data, const Binding& binding, const ProblemInfo& info,
+								const fs::Formula*& precondition, std::vector<const fs::ActionEffect*>& effects) {
 	assert(binding.is_complete()); // Grounding only possible for full bindings
-	const fs::Formula* precondition = action_data.getPrecondition()->bind(binding, info);
+	precondition = action_data.getPrecondition()->bind(binding, info);
 	if (precondition->is_contradiction()) {
 		delete precondition;
-		return nullptr;
+		precondition = nullptr;
+		return false;
 	}
 	
-	std::vector<const fs::ActionEffect*> effects;
 	for (const fs::ActionEffect* effect:action_data.getEffects()) {
 		effects.push_back(effect->bind(binding, info));
 	}
-	
-	return new GroundAction(id, action_data, binding, precondition, effects);
+	return true;
 }
 
 
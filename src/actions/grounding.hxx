@@ -3,11 +3,12 @@
 
 #include <fs_types.hxx>
 
-namespace fs0 { namespace language { namespace fstrips { class Term; class ActionEffect; }}}
+namespace fs0 { namespace language { namespace fstrips { class Term; class Formula; class ActionEffect; }}}
 namespace fs = fs0::language::fstrips;
 
 namespace fs0 {
 
+class Problem;
 class ProblemInfo;
 class ActionData;
 class ActionBase;
@@ -34,11 +35,28 @@ public:
 	//! Generate fully-lifted actions from the action schema data
 	static std::vector<const PartiallyGroundedAction*> fully_lifted(const std::vector<const ActionData*>& action_data, const ProblemInfo& info);
 	
+	//! Fully grounds the given action schemata, splitting the bindings of each schema among the given number of threads
+	//! (0 meaning as many threads as hardware threads). The IDs of the resulting actions do not depend on the number of threads.
+	//! If no number of threads is given, it is taken from the global configuration.
 	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info);
+	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, unsigned num_threads);
+	
+	//! Grounds the action schemata of the given problem, either fully or by relaxed reachability analysis from the
+	//! problem initial state, depending on the global configuration. If a grounding cache is configured, the grounded
+	//! actions are rebuilt from the cached bindings when the problem has already been grounded in the same mode.
+	static std::vector<const GroundAction*> fully_ground(const Problem& problem, const ProblemInfo& info);
 	
 	static const std::vector<const fs::ActionEffect*> compile_nested_fluents_away(const fs::ActionEffect* effect, const ProblemInfo& info);
 	
 protected:
+	friend class ReachabilityGrounder;
+	
+	//! Grounds the action schemata of the given problem as 'fully_ground' does, but without the grounding cache
+	static std::vector<const GroundAction*> ground_schemata(const Problem& problem, const ProblemInfo& info);
+	
+	//! The minimum number of bindings per thread that makes grounding a schema in parallel worthwhile
+	static const unsigned MIN_BINDINGS_PER_THREAD = 100;
+	
 	//! Helper to ground a schema with a single binding. Returns the expected next action ID, which might be the same
 	//! ID that was received, if the grounding was unsuccessful, or a consecutive one, otherwise.
 	static unsigned ground(unsigned id, const ActionData* data, const Binding& binding, const ProblemInfo& info, std::vector<const GroundAction*>& grounded);
@@ -46,6 +64,15 @@ protected:
 	//! Process the action schema with a given parameter binding and return the corresponding GroundAction
 	//! A nullptr is returned if the action is detected to be statically non-applicable
 	static GroundAction* full_binding(unsigned id, const ActionData& action_data, const Binding& binding, const ProblemInfo& info);
+	
+	//! Binds the precondition and effects of the given action schema with the given full binding.
+	//! Returns false, and binds nothing, if the action is detected to be statically non-applicable.
+	static bool bind_components(const ActionData& action_data, const Binding& binding, const ProblemInfo& info,
+								const fs::Formula*& precondition, std::vector<const fs::ActionEffect*>& effects);
+	
+	//! Grounds a schema by splitting its bindings among the given number of threads. The resulting actions are placed
+	//! in 'grounded' in the same order, and with the same IDs, as a sequential grounding would give them.
+	static unsigned ground_in_parallel(unsigned id, const ActionData* data, const ProblemInfo& info, unsigned num_threads, std::vector<const GroundAction*>& grounded);
 	static PartiallyGroundedAction* partial_binding(const ActionData& action_data, const Binding& binding, const ProblemInfo& info);
 	
 	//! Return the non-constant terms that are present as first-level subterms of the head, i.e.
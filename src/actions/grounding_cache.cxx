@@ -0,0 +1,144 @@
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <actions/grounding_cache.hxx>
+#include <actions/actions.hxx>
+#include <problem_info.hxx>
+#include <utils/serializer.hxx>
+#include <utils/plugin.hxx>
+
+namespace fs0 {
+
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+static uint64_t hash_bytes(const char* bytes, std::size_t size, uint64_t hash) {
+	for (std::size_t i = 0; i < size; ++i) {
+		hash ^= (unsigned char) bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+uint64_t GroundingCache::hash_file(const std::string& filename, uint64_t hash) {
+	std::ifstream is(filename, std::ios::binary);
+	if (!is.is_open()) return hash_bytes("-", 1, hash);
+	
+	uint64_t size = 0;
+	char buffer[1 << 16];
+	while (is) {
+		is.read(buffer, sizeof(buffer));
+		hash = hash_bytes(buffer, is.gcount(), hash);
+		size += is.gcount();
+	}
+	return hash_bytes(reinterpret_cast<const char*>(&size), sizeof(size), hash);
+}
+
+uint64_t GroundingCache::hash_image(const std::string& path, uint64_t hash) {
+	struct stat st;
+	if (path.empty() || stat(path.c_str(), &st) != 0) return hash_bytes("-", 1, hash);
+	
+	uint64_t size = st.st_size, modified = st.st_mtime;
+	hash = hash_bytes(path.c_str(), path.size() + 1, hash);
+	hash = hash_bytes(reinterpret_cast<const char*>(&size), sizeof(size), hash);
+	return hash_bytes(reinterpret_cast<const char*>(&modified), sizeof(modified), hash);
+}
+
+uint64_t GroundingCache::build_id() {
+	uint64_t hash = FNV_OFFSET;
+	
+	// The executable
+	char path[4096];
+	ssize_t length = readlink("/proc/self/exe", path, sizeof(path));
+	hash = hash_image(length > 0 ? std::string(path, length) : std::string(), hash);
+	
+	// The shared library with the grounding code, which can be rebuilt independently of the executable
+	Dl_info library;
+	bool found = dladdr(reinterpret_cast<void*>(&GroundingCache::build_id), &library) != 0 && library.dli_fname;
+	hash = hash_image(found ? std::string(library.dli_fname) : std::string(), hash);
+	
+	// The problem plugin, if any, which defines the external symbols that the grounding might prune actions with
+	return hash_image(ProblemPlugin::getLoadedPath(), hash);
+}
+
+GroundingCache::GroundingCache(const std::string& directory, const std::vector<const ActionData*>& action_data, const ProblemInfo& info, bool reachability)
+	: _action_data(action_data), _width(1), _directory(directory), _filename(), _tag(0)
+{
+	for (const ActionData* data:action_data) _width = std::max(_width, (unsigned) data->getSignature().size() + 1);
+	
+	uint32_t version = FORMAT_VERSION;
+	uint64_t build = build_id();
+	_tag = (version << 24) | (uint32_t) (build & 0xFFFFFF);
+	
+	uint64_t hash = FNV_OFFSET;
+	hash = hash_bytes(reinterpret_cast<const char*>(&version), sizeof(version), hash);
+	hash = hash_bytes(reinterpret_cast<const char*>(&build), sizeof(build), hash);
+	std::string mode = reachability ? "reachability" : "full";
+	hash = hash_bytes(mode.data(), mode.size() + 1, hash);
+	hash = hash_file(info.getDataDir() + "/problem.json", hash);
+	for (unsigned symbol = 0; symbol < info.getNumLogicalSymbols(); ++symbol) {
+		if (!info.getSymbolData(symbol).isStatic() || !info.has_extension(symbol)) continue;
+		hash = hash_file(info.getDataDir() + "/" + info.getSymbolName(symbol) + ".bin", hash);
+		hash = hash_file(info.getDataDir() + "/" + info.getSymbolName(symbol) + ".data", hash);
+	}
+	
+	std::ostringstream filename;
+	filename << _directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << ".grounding.bin";
+	_filename = filename.str();
+}
+
+bool GroundingCache::load(std::vector<Entry>& entries) const {
+	if (!std::ifstream(_filename).good()) return false;
+	
+	entries.clear();
+	Serializer::RowInserter inserter = [&](const int* row) {
+		if (row[0] < 0 || (unsigned) row[0] >= _action_data.size()) throw std::runtime_error("Unknown action schema in grounding cache " + _filename);
+		const ActionData* data = _action_data[row[0]];
+		entries.push_back(Entry(data, Binding(ValueTuple(row + 1, row + 1 + data->getSignature().size()))));
+	};
+	
+	try {
+		Serializer::deserialize(_filename, _width, inserter, _tag);
+	} catch (const std::runtime_error& e) {
+		std::cerr << "Ignoring invalid grounding cache: " << e.what() << std::endl;
+		entries.clear();
+		return false;
+	}
+	return true;
+}
+
+void GroundingCache::store(const std::vector<const GroundAction*>& grounded) const {
+	std::unordered_map<const ActionData*, int> schemata;
+	for (unsigned i = 0; i < _action_data.size(); ++i) schemata.insert(std::make_pair(_action_data[i], i));
+	
+	std::vector<int> rows;
+	rows.reserve(grounded.size() * _width);
+	for (const GroundAction* action:grounded) {
+		const Binding& binding = action->getBinding();
+		rows.push_back(schemata.at(&action->getActionData()));
+		for (unsigned i = 0; i < _width - 1; ++i) rows.push_back(i < binding.size() ? binding.value(i) : 0);
+	}
+	
+	// Write to a temporary file first, so that concurrent runs never see a partially-written cache file
+	mkdir(_directory.c_str(), 0755);
+	std::string temporary = _filename + ".tmp." + std::to_string(getpid());
+	try {
+		Serializer::serializeBinary(temporary, _width, rows, _tag);
+		if (std::rename(temporary.c_str(), _filename.c_str()) != 0) throw std::runtime_error("Could not write grounding cache " + _filename);
+	} catch (const std::runtime_error& e) {
+		std::remove(temporary.c_str());
+		std::cerr << "Grounding cache not saved: " << e.what() << std::endl;
+	}
+}
+
+} // namespaces
@@ -0,0 +1,68 @@
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <utils/binding.hxx>
+
+namespace fs0 {
+
+class ProblemInfo;
+class ActionData;
+class GroundAction;
+
+//! An on-disk cache of the actions grounded for a problem, which lets successive runs on the same instance, e.g. with
+//! different drivers or configurations, skip the enumeration of the parameter bindings of each action schema.
+//! The cache file holds, for each grounded action and in the order of their IDs, the index of its schema followed by
+//! its binding, as one row of a binary data file (see Serializer::BinaryHeader) padded to the largest schema arity,
+//! and is memory-mapped when loaded. The file is named after a hash of the problem data (problem.json plus the data
+//! files of the static symbols), of the grounding mode, of the cache format version and of the build of the planner, i.e.
+//! of the running executable, the planner library and the problem plugin, if any, so that a cache file is never used for
+//! a different problem nor read by a different build of the planner. The format version and the build are also recorded
+//! in the tag of the file header, and files with a different tag are rejected.
+//! The cache is disabled by default, and enabled by setting the 'grounding_cache' option to the directory of the cache files.
+class GroundingCache {
+public:
+	//! The version of the format of the cache files, to be increased whenever their contents change
+	static const uint32_t FORMAT_VERSION = 1;
+
+	//! A cached action, i.e. a schema plus the binding that grounds it
+	typedef std::pair<const ActionData*, Binding> Entry;
+
+	GroundingCache(const std::string& directory, const std::vector<const ActionData*>& action_data, const ProblemInfo& info, bool reachability);
+	~GroundingCache() = default;
+
+	//! Returns true, and fills 'entries' with the cached actions, iff there is a valid cache file for the problem
+	bool load(std::vector<Entry>& entries) const;
+
+	//! Saves the given actions to the cache file of the problem
+	void store(const std::vector<const GroundAction*>& grounded) const;
+
+	const std::string& getFilename() const { return _filename; }
+
+protected:
+	const std::vector<const ActionData*>& _action_data;
+
+	//! The number of integers per cached action: the schema index plus the values of the largest binding
+	unsigned _width;
+
+	std::string _directory;
+	std::string _filename;
+
+	//! The tag of the header of the cache file: the format version on the highest 8 bits, and 24 bits of the build ID
+	uint32_t _tag;
+
+	//! Updates the given FNV-1a hash with the size and the contents of the given file, if it exists
+	static uint64_t hash_file(const std::string& filename, uint64_t hash);
+
+	//! Updates the given FNV-1a hash with the path, size and modification time of the given binary image, if it exists
+	static uint64_t hash_image(const std::string& path, uint64_t hash);
+
+	//! A hash identifying the build of the planner, namely of the images of the running executable, of the shared
+	//! library with the planner code and of the problem plugin
+	static uint64_t build_id();
+};
+
+} // namespaces
@@ -0,0 +1,335 @@
+
+#include <boost/functional/hash.hpp>
+
+#include <actions/reachability_grounding.hxx>
+#include <actions/grounding.hxx>
+#include <actions/actions.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <aptk2/tools/logging.hxx>
+#include <utils/binding.hxx>
+#include <utils/static.hxx>
+#include <languages/fstrips/language.hxx>
+
+namespace fs0 {
+
+ReachabilityGrounder::ReachabilityGrounder(const std::vector<const ActionData*>& action_data, const State& init, const ProblemInfo& info) :
+	_info(info),
+	_schemas(),
+	_reached_values(info.getNumVariables()),
+	_fluent_tuples(info.getNumLogicalSymbols(), Relation{{}, {}, 0, 0}),
+	_variable_tuples(info.getNumVariables(), Relation{{}, {}, 0, 0}),
+	_static_tuples(info.getNumLogicalSymbols(), Relation{{}, {}, 0, 0}),
+	_type_objects(),
+	_changed(false)
+{
+	for (const ObjectIdxVector& objects:info.getTypeObjects()) {
+		_type_objects.push_back(std::set<ObjectIdx>(objects.begin(), objects.end()));
+	}
+
+	for (const ActionData* data:action_data) {
+		_schemas.push_back(Schema{data, {}, {}, {}});
+		analyze(data, _schemas.back().atoms);
+	}
+
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		reach(variable, init.getValue(variable));
+	}
+}
+
+void ReachabilityGrounder::analyze(const ActionData* data, std::vector<JoinAtom>& atoms) {
+	std::vector<const fs::AtomicFormula*> conjuncts;
+	const fs::Formula* precondition = data->getPrecondition();
+	if (auto conjunction = dynamic_cast<const fs::Conjunction*>(precondition)) {
+		conjuncts = conjunction->getConjuncts();
+	} else if (auto atom = dynamic_cast<const fs::AtomicFormula*>(precondition)) {
+		conjuncts.push_back(atom);
+	} // Otherwise, e.g. for existentially quantified formulas, we cannot exploit the precondition at all
+
+	const Signature& signature = data->getSignature();
+	for (const fs::AtomicFormula* conjunct:conjuncts) {
+		auto eq = dynamic_cast<const fs::EQAtomicFormula*>(conjunct);
+		if (!eq) continue;
+
+		// We want the atom in the form f(t_1, ..., t_n) = t
+		const fs::Term* head = eq->lhs();
+		const fs::Term* value = eq->rhs();
+		if (!dynamic_cast<const fs::NestedTerm*>(head) && !dynamic_cast<const fs::StateVariable*>(head)) std::swap(head, value);
+
+		JoinAtom join;
+		Argument value_argument;
+		if (!analyze_argument(value, signature, value_argument)) continue;
+
+		if (auto variable = dynamic_cast<const fs::StateVariable*>(head)) {
+			join.kind = JoinAtom::Kind::VARIABLE;
+			join.index = variable->getValue();
+
+		} else if (auto nested = dynamic_cast<const fs::NestedTerm*>(head)) {
+			unsigned symbol = nested->getSymbolId();
+			if (dynamic_cast<const fs::FluentHeadedNestedTerm*>(nested)) {
+				join.kind = JoinAtom::Kind::FLUENT;
+			} else if (dynamic_cast<const fs::UserDefinedStaticTerm*>(nested) && _info.has_extension(symbol)) {
+				// For static predicates, we only know the tuples for which they are true
+				if (_info.isPredicate(symbol) && (value_argument.is_parameter || value_argument.constant != 1)) continue;
+				join.kind = JoinAtom::Kind::STATIC;
+				Relation& extension = _static_tuples.at(symbol);
+				if (extension.tuples.empty()) extension.tuples = _info.get_extension(symbol).get_tuples();
+			} else continue;
+			join.index = symbol;
+
+			bool valid = true;
+			for (const fs::Term* subterm:nested->getSubterms()) {
+				Argument argument;
+				valid = valid && analyze_argument(subterm, signature, argument);
+				join.arguments.push_back(argument);
+			}
+			if (!valid) continue;
+
+		} else continue;
+
+		join.arguments.push_back(value_argument);
+		atoms.push_back(join);
+	}
+	LPT_DEBUG("grounding", "Reachability grounding: " << atoms.size() << " precondition atoms of schema " << data->getName() << " will be joined");
+}
+
+bool ReachabilityGrounder::analyze_argument(const fs::Term* term, const Signature& signature, Argument& argument) {
+	if (auto constant = dynamic_cast<const fs::Constant*>(term)) {
+		argument = Argument{false, 0, constant->getValue()};
+		return true;
+	}
+	if (auto parameter = dynamic_cast<const fs::BoundVariable*>(term)) {
+		// Variables bound by some quantifier other than the action parameters cannot be joined
+		if (parameter->getVariableId() >= signature.size()) return false;
+		argument = Argument{true, parameter->getVariableId(), 0};
+		return true;
+	}
+	return false;
+}
+
+std::size_t ReachabilityGrounder::TupleHash::operator()(const ValueTuple& tuple) const { return boost::hash_range(tuple.begin(), tuple.end()); }
+
+std::vector<const GroundAction*> ReachabilityGrounder::ground() {
+	// Semi-naive evaluation: on each round, every binding generated must match at least one atom
+	// against a tuple that was new in the previous round, so that no join is ever repeated
+	unsigned iteration = 0;
+	std::vector<JoinStep> steps;
+	do {
+		advance();
+		_changed = false;
+		for (Schema& schema:_schemas) {
+			unsigned arity = schema.data->getSignature().size();
+			ValueTuple values(arity);
+			std::vector<bool> set(arity, false);
+
+			if (schema.atoms.empty()) {
+				if (iteration == 0) complete(schema, 0, values, set);
+				continue;
+			}
+
+			for (unsigned delta = 0; delta < schema.atoms.size(); ++delta) {
+				const Relation& rel = relation(schema.atoms[delta]);
+				if (rel.old_end == rel.new_end) continue; // Nothing new to join with
+				plan(schema, delta, steps);
+				join(schema, steps, 0, values, set);
+			}
+		}
+		++iteration;
+	} while (_changed);
+
+	// Assign IDs in a deterministic manner
+	std::vector<const GroundAction*> grounded;
+	unsigned num_pruned = 0;
+	for (Schema& schema:_schemas) {
+		for (auto& elem:schema.reached) {
+			grounded.push_back(new GroundAction(grounded.size(), *schema.data, Binding(elem.first), elem.second.precondition, elem.second.effects));
+		}
+		num_pruned += schema.pruned.size();
+	}
+
+	LPT_INFO("grounding", "Reachability grounding stats:\n\t* " << iteration << " iterations\n\t* " << grounded.size() << " grounded actions\n\t* " << num_pruned << " statically pruned actions");
+	std::cout << "Reachability grounding stats:\n\t* " << iteration << " iterations\n\t* " << grounded.size() << " grounded actions\n\t* " << num_pruned << " statically pruned actions" << std::endl;
+	return grounded;
+}
+
+void ReachabilityGrounder::advance() {
+	for (auto relations:{&_fluent_tuples, &_variable_tuples, &_static_tuples}) {
+		for (Relation& rel:*relations) {
+			rel.old_end = rel.new_end;
+			rel.new_end = rel.tuples.size();
+		}
+	}
+}
+
+void ReachabilityGrounder::plan(Schema& schema, unsigned delta, std::vector<JoinStep>& steps) {
+	// Join first the delta atom, which is likely to have the fewest candidates, and then the rest
+	// of the atoms in increasing number of candidates, as they are likely to prune more
+	std::vector<unsigned> order;
+	for (unsigned k = 0; k < schema.atoms.size(); ++k) {
+		if (k != delta) order.push_back(k);
+	}
+	std::stable_sort(order.begin(), order.end(), [this, &schema](unsigned k1, unsigned k2) {
+		return relation(schema.atoms[k1]).new_end < relation(schema.atoms[k2]).new_end;
+	});
+	order.insert(order.begin(), delta);
+
+	steps.clear();
+	std::vector<bool> bound(schema.data->getSignature().size(), false);
+	for (unsigned k:order) {
+		const JoinAtom& atom = schema.atoms[k];
+		Relation& rel = relation(atom);
+		JoinStep step{&atom, &rel, 0, rel.new_end, {}, {}, nullptr, {}};
+		if (k < delta) step.end = rel.old_end;
+		else if (k == delta) step.begin = rel.old_end;
+
+		for (unsigned position = 0; position < atom.arguments.size(); ++position) {
+			const Argument& argument = atom.arguments[position];
+			if (!argument.is_parameter || bound[argument.parameter]) step.bound.push_back(position);
+			else step.free.push_back(position);
+		}
+		for (unsigned position:step.free) bound[atom.arguments[position].parameter] = true;
+
+		if (!step.bound.empty()) {
+			step.index = &index(rel, step.bound);
+			step.key.resize(step.bound.size());
+		}
+		steps.push_back(std::move(step));
+	}
+}
+
+ReachabilityGrounder::Index& ReachabilityGrounder::index(Relation& relation, const std::vector<unsigned>& positions) {
+	Index& index = relation.indexes.insert(std::make_pair(positions, Index{{}, 0})).first->second;
+
+	// Tuples reached during the current round are left out, so that the index does not change while being iterated
+	ValueTuple key(positions.size());
+	for (; index.indexed < relation.new_end; ++index.indexed) {
+		const ValueTuple& tuple = relation.tuples[index.indexed];
+		for (unsigned k = 0; k < positions.size(); ++k) key[k] = tuple[positions[k]];
+		index.buckets[key].push_back(index.indexed);
+	}
+	return index;
+}
+
+void ReachabilityGrounder::join(Schema& schema, std::vector<JoinStep>& steps, unsigned i, ValueTuple& values, std::vector<bool>& set) {
+	if (i == steps.size()) {
+		complete(schema, 0, values, set);
+		return;
+	}
+
+	JoinStep& step = steps[i];
+	if (!step.index) {
+		for (unsigned t = step.begin; t < step.end; ++t) match(schema, steps, i, t, values, set);
+		return;
+	}
+
+	for (unsigned k = 0; k < step.bound.size(); ++k) {
+		const Argument& argument = step.atom->arguments[step.bound[k]];
+		step.key[k] = argument.is_parameter ? values[argument.parameter] : argument.constant;
+	}
+	auto it = step.index->buckets.find(step.key);
+	if (it == step.index->buckets.end()) return;
+
+	const std::vector<unsigned>& candidates = it->second;
+	for (auto t = std::lower_bound(candidates.begin(), candidates.end(), step.begin); t != candidates.end() && *t < step.end; ++t) {
+		match(schema, steps, i, *t, values, set);
+	}
+}
+
+void ReachabilityGrounder::match(Schema& schema, std::vector<JoinStep>& steps, unsigned i, unsigned t, ValueTuple& values, std::vector<bool>& set) {
+	const JoinStep& step = steps[i];
+	const Signature& signature = schema.data->getSignature();
+
+	// Note that the tuple reference might get invalidated during the recursion, as new tuples get reached
+	const ValueTuple& tuple = step.relation->tuples[t];
+	assert(tuple.size() == step.atom->arguments.size());
+
+	bool consistent = true;
+	for (unsigned k = 0; k < step.free.size() && consistent; ++k) {
+		unsigned position = step.free[k];
+		unsigned parameter = step.atom->arguments[position].parameter;
+		if (set[parameter]) { // The same parameter appears twice in the atom
+			consistent = (values[parameter] == tuple[position]);
+		} else if (_type_objects.at(signature[parameter]).count(tuple[position])) {
+			values[parameter] = tuple[position];
+			set[parameter] = true;
+		} else {
+			consistent = false;
+		}
+	}
+
+	if (consistent) join(schema, steps, i + 1, values, set);
+
+	for (unsigned position:step.free) set[step.atom->arguments[position].parameter] = false;
+}
+
+void ReachabilityGrounder::complete(Schema& schema, unsigned parameter, ValueTuple& values, std::vector<bool>& set) {
+	const Signature& signature = schema.data->getSignature();
+	if (parameter == signature.size()) {
+		process(schema, values);
+		return;
+	}
+
+	if (set[parameter]) {
+		complete(schema, parameter + 1, values, set);
+		return;
+	}
+
+	for (ObjectIdx object:_info.getTypeObjects(signature[parameter])) {
+		values[parameter] = object;
+		complete(schema, parameter + 1, values, set);
+	}
+}
+
+void ReachabilityGrounder::process(Schema& schema, const ValueTuple& values) {
+	if (schema.reached.find(values) != schema.reached.end() || schema.pruned.find(values) != schema.pruned.end()) return;
+
+	BoundAction action{nullptr, {}};
+	Binding binding(values);
+	if (!ActionGrounder::bind_components(*schema.data, binding, _info, action.precondition, action.effects)) {
+		schema.pruned.insert(values);
+		return;
+	}
+
+	schema.reached.insert(std::make_pair(values, action));
+	for (const fs::ActionEffect* effect:action.effects) reach(effect);
+}
+
+void ReachabilityGrounder::reach(VariableIdx variable, ObjectIdx value) {
+	if (!_reached_values[variable].insert(value).second) return; // Already reached
+	_changed = true;
+
+	_variable_tuples[variable].tuples.push_back({value});
+
+	const auto& data = _info.getVariableData(variable);
+	ValueTuple tuple(data.second);
+	tuple.push_back(value);
+	_fluent_tuples[data.first].tuples.push_back(tuple);
+}
+
+void ReachabilityGrounder::reach(const fs::ActionEffect* effect) {
+	// Effect conditions are ignored, as we are over-approximating the set of reachable atoms
+	std::vector<VariableIdx> variables;
+	if (auto variable = dynamic_cast<const fs::StateVariable*>(effect->lhs())) {
+		variables.push_back(variable->getValue());
+	} else if (auto nested = dynamic_cast<const fs::FluentHeadedNestedTerm*>(effect->lhs())) {
+		variables = _info.resolveStateVariable(nested->getSymbolId()); // A nested fluent on the head might affect any of the symbol variables
+	} else throw std::runtime_error("Unsupported effect type");
+
+	auto constant = dynamic_cast<const fs::Constant*>(effect->rhs());
+	for (VariableIdx variable:variables) {
+		if (constant) reach(variable, constant->getValue());
+		else reach_all(variable);
+	}
+}
+
+void ReachabilityGrounder::reach_all(VariableIdx variable) {
+	for (ObjectIdx value:_info.getVariableObjects(variable)) reach(variable, value);
+}
+
+ReachabilityGrounder::Relation& ReachabilityGrounder::relation(const JoinAtom& atom) {
+	if (atom.kind == JoinAtom::Kind::VARIABLE) return _variable_tuples.at(atom.index);
+	if (atom.kind == JoinAtom::Kind::FLUENT) return _fluent_tuples.at(atom.index);
+	return _static_tuples.at(atom.index);
+}
+
+} // namespaces
@@ -0,0 +1,163 @@
+
+#pragma once
+
+#include <set>
+#include <map>
+#include <unordered_map>
+
+#include <fs_types.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Term; class Formula; class ActionEffect; }}}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class ProblemInfo;
+class ActionData;
+class GroundAction;
+class State;
+
+//! A grounder based on relaxed reachability, in the style of Datalog-based grounders (e.g. Helmert's). Instead of enumerating
+//! the whole cartesian product of parameter values of each action schema, it computes a fixpoint where the bindings of each schema
+//! are generated by joining the precondition atoms of the schema with the static extensions of static symbols and with the set of
+//! atoms reachable so far, which grows with the (delete-free) effects of the actions grounded so far.
+//! Only precondition atoms of the form 'f(t_1, ..., t_n) = t', where every t_i and t are action parameters or constants, are used to
+//! generate bindings; the rest of preconditions are simply ignored, which is sound, as the grounding is an over-approximation anyway.
+//! Bindings are processed by the usual static simplification of ActionGrounder, and the resulting actions get their IDs in the
+//! order of the schemata and, within a schema, in lexicographic order of the bindings, so that the grounding is deterministic.
+class ReachabilityGrounder {
+public:
+	ReachabilityGrounder(const std::vector<const ActionData*>& action_data, const State& init, const ProblemInfo& info);
+	~ReachabilityGrounder() = default;
+
+	ReachabilityGrounder(const ReachabilityGrounder&) = delete;
+	ReachabilityGrounder& operator=(const ReachabilityGrounder&) = delete;
+
+	//! Computes the reachability fixpoint and returns the resulting ground actions
+	std::vector<const GroundAction*> ground();
+
+protected:
+	//! An argument of a precondition atom, either an action parameter or a constant
+	struct Argument {
+		bool is_parameter;
+		unsigned parameter;
+		ObjectIdx constant;
+	};
+
+	//! A precondition atom 'f(t_1, ..., t_n) = t' that can be joined, either because 'f' is a static symbol with
+	//! a known extension, or because it is a fluent symbol, or because the atom is over a single state variable.
+	struct JoinAtom {
+		enum class Kind {STATIC, FLUENT, VARIABLE};
+		Kind kind;
+		unsigned index; // The symbol ID, or the state variable, depending on the kind
+		std::vector<Argument> arguments; // The arguments t_1, ..., t_n, plus the value t
+	};
+
+	//! The components of a bound action that has been found reachable
+	struct BoundAction {
+		const fs::Formula* precondition;
+		std::vector<const fs::ActionEffect*> effects;
+	};
+
+	struct Schema {
+		const ActionData* data;
+		std::vector<JoinAtom> atoms;
+		std::map<ValueTuple, BoundAction> reached; // The reachable bindings, ordered lexicographically
+		std::set<ValueTuple> pruned; // The bindings found reachable but statically non-applicable
+	};
+
+	struct TupleHash {
+		std::size_t operator()(const ValueTuple& tuple) const;
+	};
+
+	//! A hash index over the tuples of a relation, keyed on the values at a fixed subset of positions.
+	//! The buckets hold tuple indexes in increasing order, so that they can be restricted to a range of tuples.
+	struct Index {
+		std::unordered_map<ValueTuple, std::vector<unsigned>, TupleHash> buckets;
+		unsigned indexed; // The number of tuples of the relation already in the index
+	};
+
+	//! The tuples that can be matched against a join atom. Tuples are only ever appended, and the relation
+	//! keeps the boundaries of the delta of the current round: tuples [0, old_end) were already known in the
+	//! previous round, tuples [old_end, new_end) are new in this round, and any tuple after 'new_end' has been
+	//! reached during the current round and will only be considered in the next one.
+	struct Relation {
+		std::vector<ValueTuple> tuples;
+		std::map<std::vector<unsigned>, Index> indexes; // The indexes, by the positions on which they are keyed
+		unsigned old_end;
+		unsigned new_end;
+	};
+
+	//! One step of a join plan: the atom to be matched, the range of tuples of its relation to be considered,
+	//! and the positions of the atom that are already bound when the step is reached
+	struct JoinStep {
+		const JoinAtom* atom;
+		Relation* relation;
+		unsigned begin;
+		unsigned end;
+		std::vector<unsigned> bound;
+		std::vector<unsigned> free; // The remaining positions, all of which hold parameters not bound by previous steps
+		Index* index; // The index on the bound positions, or nullptr if no position is bound
+		ValueTuple key; // A buffer for the lookup key
+	};
+
+	const ProblemInfo& _info;
+
+	std::vector<Schema> _schemas;
+
+	//! The reachable values of each state variable
+	std::vector<std::set<ObjectIdx>> _reached_values;
+
+	//! For each fluent symbol, the reachable tuples <o_1, ..., o_n, v> such that f(o_1, ..., o_n) = v
+	std::vector<Relation> _fluent_tuples;
+
+	//! For each state variable, the reachable tuples <v>
+	std::vector<Relation> _variable_tuples;
+
+	//! The tuples of each static symbol that is used in some join atom
+	std::vector<Relation> _static_tuples;
+
+	//! The objects of each type, for fast membership checks
+	std::vector<std::set<ObjectIdx>> _type_objects;
+
+	//! Whether any new atom has been reached in the current iteration
+	bool _changed;
+
+	//! Analyzes the precondition of the given action schema to extract the atoms that can be joined
+	void analyze(const ActionData* data, std::vector<JoinAtom>& atoms);
+
+	//! Returns true and fills 'argument' iff the given term is an action parameter of the given signature or a constant
+	static bool analyze_argument(const fs::Term* term, const Signature& signature, Argument& argument);
+
+	//! Registers as reachable the given atom / the atoms that might be produced by the given (bound) effect
+	void reach(VariableIdx variable, ObjectIdx value);
+	void reach(const fs::ActionEffect* effect);
+	void reach_all(VariableIdx variable);
+
+	//! Returns the relation against which a join atom is to be matched
+	Relation& relation(const JoinAtom& atom);
+
+	//! Moves the delta boundaries of all relations to the tuples reached during the last round
+	void advance();
+
+	//! Builds the plan that joins the atoms of the given schema restricting the 'delta'-th atom to the tuples new in
+	//! the current round, the atoms before it to the tuples known in the previous round, and the atoms after it to all tuples
+	void plan(Schema& schema, unsigned delta, std::vector<JoinStep>& steps);
+
+	//! Returns the index of the given relation keyed on the given positions, indexing first any tuple not yet in it
+	static Index& index(Relation& relation, const std::vector<unsigned>& positions);
+
+	//! Recursively enumerates all bindings of the given schema consistent with the join steps from position 'i' onwards
+	void join(Schema& schema, std::vector<JoinStep>& steps, unsigned i, ValueTuple& values, std::vector<bool>& set);
+
+	//! Matches the 't'-th tuple of the relation of the i-th step and, if consistent, recurses into the next step
+	void match(Schema& schema, std::vector<JoinStep>& steps, unsigned i, unsigned t, ValueTuple& values, std::vector<bool>& set);
+
+	//! Enumerates all values of the parameters not bound by any join atom
+	void complete(Schema& schema, unsigned parameter, ValueTuple& values, std::vector<bool>& set);
+
+	//! Processes a full binding of the given schema
+	void process(Schema& schema, const ValueTuple& values);
+};
+
+} // namespaces
@@ -9,18 +9,20 @@ namespace fs0 {
 
 
 ApplicabilityManager::ApplicabilityManager(const fs::Formula* state_constraints)
-	: _state_constraints(state_constraints) {}
+	: _state_constraints(state_constraints), _compiled_constraints(state_constraints) {}
 	
 //! An action is applicable iff its preconditions hold and its application does not violate any state constraint.
 bool ApplicabilityManager::isApplicable(const State& state, const GroundAction& action) const {
-	if (!checkFormulaHolds(action.getPrecondition(), state)) return false;
-	
-	auto atoms = computeEffects(state, action);
+	if (!action.precondition_holds(state)) return false;
+	return checkEffectsAreValid(state, action);
+}
+
+bool ApplicabilityManager::checkEffectsAreValid(const State& state, const GroundAction& action) const {
+	const std::vector<Atom>& atoms = computeScratchEffects(state, action);
 	if (!checkAtomsWithinBounds(atoms)) return false;
 		
 	if (!_state_constraints->is_tautology()) { // If we have no constraints, we can spare the cost of creating the new state.
-		State next(state, atoms);
-		return checkFormulaHolds(_state_constraints, next);
+		return _compiled_constraints.interpret(computeScratchSuccessor(state, action));
 	}
 	return true;
 }
@@ -28,12 +30,54 @@ bool ApplicabilityManager::isApplicable(const State& state, const GroundAction&
 //! Note that this might return some repeated atom - and even two contradictory atoms... we don't check that here.
 std::vector<Atom> ApplicabilityManager::computeEffects(const State& state, const GroundAction& action) {
 	Atom::vctr atoms;
+	computeEffects(state, action, atoms);
+	return atoms;
+}
+
+void ApplicabilityManager::computeEffects(const State& state, const GroundAction& action, std::vector<Atom>& atoms) {
+	atoms.clear();
 	for (const fs::ActionEffect* effect:action.getEffects()) {
 		if (effect->applicable(state)) {
 			atoms.push_back(effect->apply(state));
 		}
 	}
-	return atoms;
+}
+
+ApplicabilityManager::Scratch& ApplicabilityManager::scratch() {
+	static thread_local Scratch theScratch;
+	return theScratch;
+}
+
+const std::vector<Atom>& ApplicabilityManager::computeScratchEffects(const State& state, const GroundAction& action) {
+	Scratch& data = scratch();
+	if (data.action == &action && data.parent == &state && data.parent_hash == state.hash()) return data.atoms; // The effects are already computed
+	
+	data.parent = &state;
+	data.parent_hash = state.hash();
+	data.action = &action;
+	data.has_successor = false;
+	computeEffects(state, action, data.atoms);
+	return data.atoms;
+}
+
+const State& ApplicabilityManager::computeScratchSuccessor(const State& state, const GroundAction& action) {
+	const std::vector<Atom>& atoms = computeScratchEffects(state, action);
+	Scratch& data = scratch();
+	if (!data.has_successor) {
+		if (data.successor) *data.successor = state; // Reuse the already-allocated storage
+		else data.successor = std::unique_ptr<State>(new State(state));
+		data.successor->accumulate(atoms);
+		data.has_successor = true;
+	}
+	return *data.successor;
+}
+
+State ApplicabilityManager::computeSuccessor(const State& state, const GroundAction& action) {
+	const std::vector<Atom>& atoms = computeScratchEffects(state, action);
+	Scratch& data = scratch();
+	if (!data.has_successor) return State(state, atoms);
+	data.has_successor = false; // The effects remain valid, but the successor is handed over to the caller
+	return std::move(*data.successor);
 }
 
 bool ApplicabilityManager::checkFormulaHolds(const fs::Formula* formula, const State& state) {
@@ -1,7 +1,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include <fs_types.hxx>
+#include <languages/fstrips/bytecode.hxx>
 
 namespace fs0 { namespace language { namespace fstrips { class Formula; } }}
 namespace fs = fs0::language::fstrips;
@@ -18,9 +21,24 @@ public:
 	//! An action is applicable iff its preconditions hold and its application does not violate any state constraint.
 	bool isApplicable(const State& state, const GroundAction& action) const;
 	
+	//! Checks that the application of an action whose preconditions are already known to hold in the given state
+	//! does not violate any domain bound nor state constraint.
+	bool checkEffectsAreValid(const State& state, const GroundAction& action) const;
+	
 	//! Note that this might return some repeated atom - and even two contradictory atoms... we don't check that here.
 	static std::vector<Atom> computeEffects(const State& state, const GroundAction& action);
 	
+	//! Same as above, but the atoms are placed in the given buffer, which is cleared first.
+	static void computeEffects(const State& state, const GroundAction& action, std::vector<Atom>& atoms);
+	
+	//! Returns the state resulting from applying the given action to the given state. The effects of the action are
+	//! computed only once per thread, i.e. they are reused if the applicability of the same action on the same state
+	//! has just been checked, as is the case when a successor is generated right after checking its applicability.
+	//! The returned reference points to a per-thread buffer which is overwritten by the next call to any method of this class.
+	//! 'computeSuccessor' moves the successor out of the buffer if it was already built.
+	static const std::vector<Atom>& computeScratchEffects(const State& state, const GroundAction& action);
+	static State computeSuccessor(const State& state, const GroundAction& action);
+	
 	static bool checkFormulaHolds(const fs::Formula* formula, const State& state);
 	
 	//! Checks that all of the given new atoms do not violate domain bounds
@@ -29,6 +47,27 @@ public:
 protected:
 	//! The state constraints
 	const fs::Formula* _state_constraints;
+	
+	//! The state constraints, compiled if possible
+	fs::CompiledFormula _compiled_constraints;
+	
+	//! A per-thread scratch area with the effects of the last action processed by the thread on the given parent state
+	//! and, if it was necessary to build it, the resulting successor state. The buffers are reused across calls,
+	//! so that no allocation is necessary once they have grown to their final size. The parent is identified by its
+	//! address and its hash, rather than copied, since it is the same object through all the calls made on it.
+	struct Scratch {
+		const State* parent = nullptr;
+		std::size_t parent_hash = 0;
+		const GroundAction* action = nullptr;
+		std::vector<Atom> atoms;
+		std::unique_ptr<State> successor;
+		bool has_successor = false;
+	};
+	
+	static Scratch& scratch();
+	
+	//! Returns the successor state stored in the scratch area, building it first if necessary.
+	static const State& computeScratchSuccessor(const State& state, const GroundAction& action);
 };
 
 } // namespaces
@@ -8,9 +8,11 @@
 namespace fs0 {
 
 FormulaInterpreter* FormulaInterpreter::create(const fs::Formula* formula, const TupleIndex& tuple_index) {
-	// If there is some quantified variable in the formula, we will use a CSP-based interpreter
+	// If there is some quantified variable in the formula, we will use a CSP-based interpreter, unless the formula
+	// is closed and can thus be directly evaluated through a join, which is then built
 	auto existential_formulae = Utils::filter_by_type<const fs::ExistentiallyQuantifiedFormula*>(formula->all_formulae());
-	if (!existential_formulae.empty()) {
+	bool joinable = existential_formulae.size() == 1 && existential_formulae[0] == formula && existential_formulae[0]->prepare_join();
+	if (!existential_formulae.empty() && !joinable) {
 		LPT_INFO("main", "Created a CSP sat. manager for formula: " << *formula);
 		// TODO - Note that we are cloning the formula here because otherwise the destructor of the interpreter will attempt to
 		// delete it, but the ownership does actually not belong to him.
@@ -27,7 +29,7 @@ DirectFormulaInterpreter::DirectFormulaInterpreter(const fs::Formula* formula) :
 {}
 
 bool DirectFormulaInterpreter::satisfied(const State& state) const {
-	return _formula->interpret(state);
+	return _formula.interpret(state);
 }
 
 
@@ -41,7 +43,11 @@ CSPFormulaInterpreter::CSPFormulaInterpreter(const fs::Formula* formula, const T
 {}
 
 bool CSPFormulaInterpreter::satisfied(const State& state) const {
-	gecode::GecodeCSP* csp = _formula_csp->instantiate(state);
+	gecode::GecodeCSP* csp = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(_instantiation_mutex);
+		csp = _formula_csp->instantiate(state);
+	}
 	if (!csp) return false;
 	csp->checkConsistency();
 	bool sol = _formula_csp->is_satisfiable(csp);
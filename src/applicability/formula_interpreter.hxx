@@ -2,6 +2,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+
+#include <languages/fstrips/bytecode.hxx>
 
 namespace fs0 { class TupleIndex; }
 namespace fs0 { namespace language { namespace fstrips { class Formula; }}}
@@ -36,8 +39,8 @@ public:
 	bool satisfied(const State& state) const;
 
 protected:
-	//! The formula whose satisfiability will be directly checked
-	const fs::Formula* _formula;
+	//! The formula whose satisfiability will be directly checked, compiled if possible
+	fs::CompiledFormula _formula;
 };
 
 
@@ -53,6 +56,10 @@ public:
 protected:
 	//! The formula handler that will check for CSP applicability
 	const gecode::FormulaCSP* _formula_csp;
+	
+	//! Cloning the base Gecode space of the formula CSP is not thread-safe, and the (global) goal interpreter might
+	//! be used concurrently by several search threads
+	mutable std::mutex _instantiation_mutex;
 };
 
 } // namespaces
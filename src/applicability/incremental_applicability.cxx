@@ -0,0 +1,172 @@
+
+#include <applicability/incremental_applicability.hxx>
+#include <applicability/successor_generator.hxx>
+#include <actions/actions.hxx>
+#include <problem.hxx>
+#include <problem_info.hxx>
+#include <atom.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/scopes.hxx>
+
+namespace fs0 {
+
+IncrementalApplicabilityTracker::IncrementalApplicabilityTracker(const Problem& problem) :
+	_problem(problem),
+	_relevant(ProblemInfo::getInstance().getNumVariables()),
+	_parents(),
+	_differences(),
+	_order(),
+	_expanded(INVALID_STATE),
+	_expanded_state(nullptr),
+	_generation(StateRegistry::instance().generation()),
+	_marks(problem.getGroundActions().size(), 0),
+	_current_mark(0)
+{
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const auto& actions = problem.getGroundActions();
+	for (ActionIdx action = 0; action < actions.size(); ++action) {
+		const fs::Formula* precondition = actions[action]->getPrecondition();
+		
+		// The relevant variables are those directly appearing in the precondition plus all those that any nested fluent might resolve to
+		std::set<VariableIdx> relevant;
+		fs::ScopeUtils::computeDirectScope(precondition, relevant);
+		fs::ScopeUtils::TermSet nested;
+		fs::ScopeUtils::computeIndirectScope(precondition, nested);
+		for (const fs::FluentHeadedNestedTerm* term:nested) {
+			const auto& possible = info.resolveStateVariable(term->getSymbolId());
+			relevant.insert(possible.cbegin(), possible.cend());
+		}
+		
+		for (VariableIdx variable:relevant) _relevant[variable].push_back(action);
+	}
+}
+
+IncrementalApplicabilityTracker::IncrementalApplicabilityTracker(const IncrementalApplicabilityTracker& other) :
+	_problem(other._problem),
+	_relevant(other._relevant),
+	_parents(),
+	_differences(),
+	_order(),
+	_expanded(INVALID_STATE),
+	_expanded_state(nullptr),
+	_generation(StateRegistry::instance().generation()),
+	_marks(other._marks.size(), 0),
+	_current_mark(0)
+{}
+
+void IncrementalApplicabilityTracker::synchronize() {
+	unsigned generation = StateRegistry::instance().generation();
+	if (generation == _generation) return;
+	_generation = generation;
+	_parents.clear();
+	_differences.clear();
+	_order.clear();
+	_expanded = INVALID_STATE;
+	_expanded_state = nullptr;
+}
+
+void IncrementalApplicabilityTracker::release(std::unordered_map<StateIdx, Difference>::iterator it) {
+	auto parent = _parents.find(it->second.parent);
+	assert(parent != _parents.end() && parent->second.pending > 0);
+	if (--parent->second.pending == 0 && parent->first != _expanded) _parents.erase(parent);
+	_differences.erase(it);
+}
+
+std::vector<ActionIdx> IncrementalApplicabilityTracker::expand(const State& state) {
+	synchronize();
+	
+	// The set of the previously expanded state is no longer needed unless some of its children needs it
+	if (_expanded != INVALID_STATE) {
+		auto previous = _parents.find(_expanded);
+		if (previous != _parents.end() && previous->second.pending == 0) _parents.erase(previous);
+	}
+	
+	_expanded = StateRegistry::instance().find(state);
+	_expanded_state = (_expanded == INVALID_STATE) ? nullptr : &StateRegistry::instance().get(_expanded);
+	
+	std::vector<ActionIdx> actions;
+	auto it = (_expanded == INVALID_STATE) ? _differences.end() : _differences.find(_expanded);
+	if (it != _differences.end()) {
+		const Difference& difference = it->second;
+		const std::vector<ActionIdx>& inherited = _parents.at(difference.parent).actions;
+		std::vector<ActionIdx> kept;
+		kept.reserve(inherited.size());
+		std::set_difference(inherited.begin(), inherited.end(), difference.removed.begin(), difference.removed.end(), std::back_inserter(kept));
+		actions.reserve(kept.size() + difference.added.size());
+		std::merge(kept.begin(), kept.end(), difference.added.begin(), difference.added.end(), std::back_inserter(actions));
+		release(it);
+	} else {
+		actions = compute(state);
+	}
+	
+	if (_expanded != INVALID_STATE) {
+		Parent& parent = _parents[_expanded];
+		parent.actions = actions;
+	}
+	return actions;
+}
+
+void IncrementalApplicabilityTracker::derive(const State& parent, const std::vector<Atom>& atoms, const State& child) {
+	synchronize();
+	if (!_expanded_state || _expanded_state != &parent) return; // We can only derive sets from the (registered) state under expansion
+	
+	// The child is registered right away, as the search node that will hold it would do anyway
+	StateIdx idx = StateRegistry::instance().intern(child);
+	if (idx == _expanded || _differences.find(idx) != _differences.end()) return;
+	
+	// Gather all the actions relevant to some changed variable, each only once
+	if (++_current_mark == 0) { // Reset the marks on overflow
+		std::fill(_marks.begin(), _marks.end(), 0);
+		_current_mark = 1;
+	}
+	const std::vector<ActionIdx>& inherited = _parents.at(_expanded).actions;
+	Difference difference{_expanded, {}, {}};
+	for (const Atom& atom:atoms) {
+		VariableIdx variable = atom.getVariable();
+		if (parent.getValue(variable) == child.getValue(variable)) continue;
+		for (ActionIdx action:_relevant[variable]) {
+			if (_marks[action] == _current_mark) continue;
+			_marks[action] = _current_mark;
+			bool before = std::binary_search(inherited.begin(), inherited.end(), action);
+			bool after = holds(action, child);
+			if (after && !before) difference.added.push_back(action);
+			if (before && !after) difference.removed.push_back(action);
+		}
+	}
+	std::sort(difference.added.begin(), difference.added.end());
+	std::sort(difference.removed.begin(), difference.removed.end());
+	
+	++_parents.at(_expanded).pending;
+	_differences.insert(std::make_pair(idx, std::move(difference)));
+	_order.push_back(idx);
+	
+	// Evict the oldest differences beyond the budget, and drop from the front of the queue the children already expanded
+	while (!_order.empty()) {
+		auto it = _differences.find(_order.front());
+		if (it != _differences.end() && _differences.size() <= MAX_PENDING) break;
+		if (it != _differences.end()) release(it);
+		_order.pop_front();
+	}
+	if (_order.size() > 2 * MAX_PENDING) {
+		std::deque<StateIdx> pending;
+		for (StateIdx child:_order) {
+			if (_differences.find(child) != _differences.end()) pending.push_back(child);
+		}
+		_order.swap(pending);
+	}
+}
+
+std::vector<ActionIdx> IncrementalApplicabilityTracker::compute(const State& state) const {
+	std::vector<ActionIdx> candidates, actions;
+	_problem.getSuccessorGenerator().generate(state, candidates);
+	for (ActionIdx action:candidates) {
+		if (_problem.getSuccessorGenerator().isFullyIndexed(action) || holds(action, state)) actions.push_back(action);
+	}
+	return actions;
+}
+
+bool IncrementalApplicabilityTracker::holds(ActionIdx action, const State& state) const {
+	return _problem.getGroundActions()[action]->precondition_holds(state);
+}
+
+} // namespaces
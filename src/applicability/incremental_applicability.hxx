@@ -0,0 +1,94 @@
+
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+
+#include <fs_types.hxx>
+#include <state.hxx>
+#include <state_registry.hxx>
+
+namespace fs0 {
+
+class Problem; class Atom;
+
+//! An incremental applicability tracker that avoids recomputing from scratch the set of actions whose preconditions
+//! hold in every expanded state. When a state is expanded, its set of actions with satisfied preconditions is kept,
+//! and for each of its children only the preconditions of those actions relevant to some variable changed by the effects
+//! leading to the child are re-evaluated. Each child only keeps the difference between its set and that of its parent,
+//! keyed by the index of the child in the state registry, and the set of a parent is kept only while some of its
+//! children has a pending difference. Children that never get expanded (e.g. because they are pruned or remain in the
+//! open list) are evicted in order of derivation once there are more than MAX_PENDING pending differences.
+//! States for which no difference is known, as well as states not in the state registry, are processed from scratch.
+class IncrementalApplicabilityTracker {
+public:
+	//! The maximum number of children with a pending difference
+	static const unsigned MAX_PENDING = 1 << 16;
+
+	IncrementalApplicabilityTracker(const Problem& problem);
+	~IncrementalApplicabilityTracker() = default;
+
+	//! A tracker with the same relevant actions as the given one, but none of its tracked states, which refer to the
+	//! state registry of the thread of the given tracker
+	IncrementalApplicabilityTracker(const IncrementalApplicabilityTracker& other);
+	IncrementalApplicabilityTracker& operator=(const IncrementalApplicabilityTracker&) = delete;
+
+	//! Returns the IDs, in increasing order, of all actions whose preconditions hold in the given state,
+	//! which becomes the state under expansion.
+	std::vector<ActionIdx> expand(const State& state);
+
+	//! Registers that the given child state results from applying the given atoms to the given parent state.
+	//! If the parent is the state under expansion, the difference between the sets of actions of the child and the
+	//! parent is computed and kept until the child is expanded.
+	void derive(const State& parent, const std::vector<Atom>& atoms, const State& child);
+
+protected:
+	//! The actions gained and lost by a child with respect to its parent, both sorted by ID
+	struct Difference {
+		StateIdx parent;
+		std::vector<ActionIdx> added;
+		std::vector<ActionIdx> removed;
+	};
+
+	//! The actions of an expanded state, and the number of its children with a pending difference
+	struct Parent {
+		std::vector<ActionIdx> actions;
+		unsigned pending;
+	};
+
+	const Problem& _problem;
+
+	//! '_relevant[v]' contains the IDs of all actions whose precondition is relevant to state variable 'v'
+	std::vector<std::vector<ActionIdx>> _relevant;
+
+	std::unordered_map<StateIdx, Parent> _parents;
+	std::unordered_map<StateIdx, Difference> _differences;
+
+	//! The children with a difference, in order of derivation, which may include children whose difference is already gone
+	std::deque<StateIdx> _order;
+
+	//! The state currently under expansion, if it is registered, and the registered object
+	StateIdx _expanded;
+	const State* _expanded_state;
+
+	//! The generation of the state registry to which the indexes above refer
+	unsigned _generation;
+
+	//! A marker to quickly tell whether an action has already been re-evaluated for the current child
+	std::vector<unsigned> _marks;
+	unsigned _current_mark;
+
+	//! Forgets everything if the state registry has been cleared since the last call
+	void synchronize();
+
+	//! Removes the difference of the given child, releasing the set of its parent if no other child needs it
+	void release(std::unordered_map<StateIdx, Difference>::iterator it);
+
+	//! Computes from scratch the set of actions whose preconditions hold in the given state
+	std::vector<ActionIdx> compute(const State& state) const;
+
+	//! Returns true iff the precondition of the given action holds in the given state
+	bool holds(ActionIdx action, const State& state) const;
+};
+
+} // namespaces
@@ -0,0 +1,136 @@
+
+#include <map>
+
+#include <applicability/successor_generator.hxx>
+#include <actions/actions.hxx>
+#include <state.hxx>
+#include <languages/fstrips/language.hxx>
+
+namespace fs0 {
+
+const unsigned SuccessorGenerator::NO_NODE = std::numeric_limits<unsigned>::max();
+
+SuccessorGenerator::SuccessorGenerator(const std::vector<const GroundAction*>& actions) :
+	_nodes(), _fully_indexed(actions.size(), false)
+{
+	std::vector<std::vector<Condition>> conditions(actions.size());
+	std::vector<ActionIdx> all(actions.size());
+	for (ActionIdx action = 0; action < actions.size(); ++action) {
+		all[action] = action;
+		_fully_indexed[action] = extract_conditions(actions[action]->getPrecondition(), conditions[action]);
+		std::sort(conditions[action].begin(), conditions[action].end());
+		conditions[action].erase(std::unique(conditions[action].begin(), conditions[action].end()), conditions[action].end());
+	}
+
+	std::vector<unsigned> cursors(actions.size(), 0);
+	build(all, conditions, cursors);
+}
+
+unsigned SuccessorGenerator::build(const std::vector<ActionIdx>& actions, const std::vector<std::vector<Condition>>& conditions, std::vector<unsigned>& cursors) {
+	unsigned node_idx = _nodes.size();
+	_nodes.push_back(Node{INVALID_VARIABLE, {}, NO_NODE, {}});
+
+	// The variable tested by the node is the lowest variable among the untested conditions of all actions
+	VariableIdx variable = INVALID_VARIABLE;
+	for (ActionIdx action:actions) {
+		if (cursors[action] == conditions[action].size()) {
+			_nodes[node_idx].immediate.push_back(action);
+		} else {
+			variable = std::min(variable, conditions[action][cursors[action]].first);
+		}
+	}
+	if (variable == INVALID_VARIABLE) return node_idx; // A leaf node
+
+	std::map<ObjectIdx, std::vector<ActionIdx>> by_value;
+	std::vector<ActionIdx> dont_care;
+	for (ActionIdx action:actions) {
+		if (cursors[action] == conditions[action].size()) continue;
+		const Condition& condition = conditions[action][cursors[action]];
+		if (condition.first == variable) {
+			by_value[condition.second].push_back(action);
+			++cursors[action];
+		} else {
+			dont_care.push_back(action);
+		}
+	}
+
+	// Note that the recursive calls might reallocate the node vector, so we cannot keep references to the current node
+	_nodes[node_idx].variable = variable;
+	for (const auto& it:by_value) {
+		unsigned child = build(it.second, conditions, cursors);
+		_nodes[node_idx].children.push_back(std::make_pair(it.first, child));
+	}
+	if (!dont_care.empty()) {
+		unsigned child = build(dont_care, conditions, cursors);
+		_nodes[node_idx].dont_care = child;
+	}
+	return node_idx;
+}
+
+void SuccessorGenerator::generate(const State& state, std::vector<ActionIdx>& candidates) const {
+	candidates.clear();
+	if (_nodes.empty()) return;
+
+	// The traversal stack is reused across calls, and kept per thread since the generator is shared by all search threads
+	static thread_local std::vector<unsigned> open;
+	open.assign(1, 0);
+	while (!open.empty()) {
+		const Node& node = _nodes[open.back()];
+		open.pop_back();
+		candidates.insert(candidates.end(), node.immediate.begin(), node.immediate.end());
+		if (node.variable == INVALID_VARIABLE) continue;
+
+		if (node.dont_care != NO_NODE) open.push_back(node.dont_care);
+
+		ObjectIdx value = state.getValue(node.variable);
+		auto it = std::lower_bound(node.children.begin(), node.children.end(), value,
+								   [](const std::pair<ObjectIdx, unsigned>& child, ObjectIdx v) { return child.first < v; });
+		if (it != node.children.end() && it->first == value) open.push_back(it->second);
+	}
+
+	// Return the candidates in the order of the original action list, to keep the search fully deterministic
+	std::sort(candidates.begin(), candidates.end());
+}
+
+bool SuccessorGenerator::extract_conditions(const fs::Formula* precondition, std::vector<Condition>& conditions) {
+	std::vector<const fs::AtomicFormula*> atoms;
+	if (precondition->is_tautology()) {
+		return true;
+	} else if (auto conjunction = dynamic_cast<const fs::Conjunction*>(precondition)) {
+		atoms = conjunction->getConjuncts();
+	} else if (auto atom = dynamic_cast<const fs::AtomicFormula*>(precondition)) {
+		atoms.push_back(atom);
+	} else {
+		return false;
+	}
+
+	bool all_indexed = true;
+	for (const fs::AtomicFormula* atom:atoms) {
+		auto eq = dynamic_cast<const fs::EQAtomicFormula*>(atom);
+		if (!eq) {
+			all_indexed = false;
+			continue;
+		}
+
+		auto lhs_var = dynamic_cast<const fs::StateVariable*>(eq->lhs());
+		auto rhs_var = dynamic_cast<const fs::StateVariable*>(eq->rhs());
+		auto lhs_const = dynamic_cast<const fs::Constant*>(eq->lhs());
+		auto rhs_const = dynamic_cast<const fs::Constant*>(eq->rhs());
+		if (lhs_var && rhs_const) {
+			conditions.push_back(std::make_pair(lhs_var->getValue(), rhs_const->getValue()));
+		} else if (rhs_var && lhs_const) {
+			conditions.push_back(std::make_pair(rhs_var->getValue(), lhs_const->getValue()));
+		} else {
+			all_indexed = false;
+		}
+	}
+	return all_indexed;
+}
+
+std::ostream& SuccessorGenerator::print(std::ostream& os) const {
+	unsigned num_indexed = std::count(_fully_indexed.begin(), _fully_indexed.end(), true);
+	os << "SuccessorGenerator[" << _nodes.size() << " nodes, " << num_indexed << "/" << _fully_indexed.size() << " actions fully indexed]";
+	return os;
+}
+
+} // namespaces
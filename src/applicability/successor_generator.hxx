@@ -0,0 +1,75 @@
+
+#pragma once
+
+#include <fs_types.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; } }}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class GroundAction; class State;
+
+//! A successor generator in the style of Fast Downward's: a match tree built over the atomic preconditions
+//! of the form X = c of all ground actions, which allows us to enumerate the actions whose atomic preconditions
+//! hold in a given state without checking every single ground action. Every inner node of the tree tests the value
+//! of one state variable, and has one child for every value of the variable that some action requires, plus one
+//! "don't care" child for those actions that don't care about the variable. Variables are tested in increasing order.
+//! Preconditions that are not simple atoms (e.g. existentially quantified formulas, or relations among several
+//! state variables) are not indexed, and need to be checked afterwards on the candidates returned by the generator.
+class SuccessorGenerator {
+public:
+	SuccessorGenerator(const std::vector<const GroundAction*>& actions);
+	~SuccessorGenerator() = default;
+
+	SuccessorGenerator(const SuccessorGenerator&) = delete;
+	SuccessorGenerator& operator=(const SuccessorGenerator&) = delete;
+
+	//! Places in 'candidates' the IDs, in increasing order, of those actions whose indexed preconditions hold in the given state.
+	void generate(const State& state, std::vector<ActionIdx>& candidates) const;
+
+	//! Returns true iff the whole precondition of the given action is indexed by the tree, i.e. iff being returned as
+	//! a candidate implies that the precondition of the action holds.
+	bool isFullyIndexed(ActionIdx action) const { return _fully_indexed[action]; }
+
+	//! The number of nodes of the tree
+	unsigned size() const { return _nodes.size(); }
+
+	//! Prints a representation of the object to the given stream.
+	friend std::ostream& operator<<(std::ostream &os, const SuccessorGenerator& o) { return o.print(os); }
+	std::ostream& print(std::ostream& os) const;
+
+protected:
+	typedef std::pair<VariableIdx, ObjectIdx> Condition;
+
+	static const unsigned NO_NODE;
+
+	struct Node {
+		//! The variable tested by the node, or INVALID_VARIABLE if the node is a leaf
+		VariableIdx variable;
+
+		//! The children for each possible value of the variable, sorted by value
+		std::vector<std::pair<ObjectIdx, unsigned>> children;
+
+		//! The child for those actions that don't care about the value of the variable
+		unsigned dont_care;
+
+		//! The actions all of whose indexed preconditions have already been tested when reaching this node
+		std::vector<ActionIdx> immediate;
+	};
+
+	//! The nodes of the tree; the first node is the root
+	std::vector<Node> _nodes;
+
+	//! Whether the whole precondition of each action is indexed by the tree
+	std::vector<bool> _fully_indexed;
+
+	//! Recursively builds the subtree for the given actions and returns the index of its root. 'cursors' marks, for each action,
+	//! the position of the first condition that has not yet been tested in the path from the root of the tree.
+	unsigned build(const std::vector<ActionIdx>& actions, const std::vector<std::vector<Condition>>& conditions, std::vector<unsigned>& cursors);
+
+	//! Extracts the conditions of the form X = c from the given formula, and returns true iff the formula consists only of such conditions.
+	static bool extract_conditions(const fs::Formula* precondition, std::vector<Condition>& conditions);
+};
+
+} // namespaces
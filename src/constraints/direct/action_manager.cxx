@@ -128,9 +128,8 @@ DirectActionManager::processEffects(unsigned actionIdx, const DomainMap& actionP
 
 			if (hint.first) {
 				LPT_EDEBUG("heuristic", "Processing effect \"" << *effect << "\" yields " << (hint.first ? "new" : "repeated") << " atom " << atom);
-				Atom::vctrp support = std::make_shared<Atom::vctr>();
-				completeAtomSupport(_scope, actionProjection, effectScope, support);
-				rpg.add(atom, get_action_id(actionIdx), support, hint.second);
+				completeAtomSupport(_scope, actionProjection, effectScope, rpg);
+				rpg.add(atom, rpg.action_id(&_action), hint.second);
 			}
 		}
 
@@ -143,10 +142,9 @@ DirectActionManager::processEffects(unsigned actionIdx, const DomainMap& actionP
 
 				if (hint.first) {
 					LPT_EDEBUG("heuristic", "Processing effect \"" << *effect << "\" yields " << (hint.first ? "new" : "repeated") << " atom " << atom);
-					Atom::vctrp support = std::make_shared<Atom::vctr>();
-					support->push_back(Atom(effectScope[0], value));// Just insert the only value
-					completeAtomSupport(_scope, actionProjection, effectScope, support);
-					rpg.add(atom, get_action_id(actionIdx), support, hint.second);
+					rpg.push_support(Atom(effectScope[0], value));// Just insert the only value
+					completeAtomSupport(_scope, actionProjection, effectScope, rpg);
+					rpg.add(atom, rpg.action_id(&_action), hint.second);
 				}
 			}
 		}
@@ -157,11 +155,11 @@ DirectActionManager::processEffects(unsigned actionIdx, const DomainMap& actionP
 }
 
 void
-DirectActionManager::completeAtomSupport(const VariableIdxVector& actionScope, const DomainMap& actionProjection, const VariableIdxVector& effectScope, Atom::vctrp support) const {
+DirectActionManager::completeAtomSupport(const VariableIdxVector& actionScope, const DomainMap& actionProjection, const VariableIdxVector& effectScope, RPGData& rpg) const {
 	for (VariableIdx variable:actionScope) {
 		if (effectScope.empty() || variable != effectScope[0]) { // (We know that the effect scope has at most one variable)
 			ObjectIdx value = *(actionProjection.at(variable)->cbegin());
-			support->push_back(Atom(variable, value));
+			rpg.push_support(Atom(variable, value));
 		}
 	}
 }
@@ -173,9 +171,4 @@ DirectActionManager::print(std::ostream& os) const {
 	return os;
 }
 
-const ActionID*
-DirectActionManager::get_action_id(unsigned action_idx) const {
-	return new PlainActionID(&_action);
-}
-
 } // namespaces
@@ -56,14 +56,12 @@ protected:
 	
 	const DirectCSPHandler _handler;
 	
-	//!
-	void completeAtomSupport(const VariableIdxVector& actionScope, const DomainMap& actionProjection, const VariableIdxVector& effectScope, std::shared_ptr<std::vector<Atom>> support) const;
+	//! Pushes into the RPG the atoms of the action scope (other than the effect scope) that support the atom about to be added
+	void completeAtomSupport(const VariableIdxVector& actionScope, const DomainMap& actionProjection, const VariableIdxVector& effectScope, RPGData& rpg) const;
 	
 	//! Extracts all the (direct) state variables that are relevant to the action
 	VariableIdxVector extractAllRelevant() const;
 	
-	const ActionID* get_action_id(unsigned action_idx) const;
-	
 	friend std::ostream& operator<<(std::ostream &os, const DirectActionManager& o) { return o.print(os); }
 	std::ostream& print(std::ostream& os) const;
 };
@@ -0,0 +1,196 @@
+
+#include <constraints/direct/table_csp.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/scopes.hxx>
+#include <utils/tuple_index.hxx>
+#include <problem_info.hxx>
+
+namespace fs0 {
+
+std::unique_ptr<DirectTableCSP> DirectTableCSP::create(const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects,
+													   const TupleIndex& tuple_index, const ProblemInfo& info) {
+	std::vector<const fs::AtomicFormula*> atoms;
+	if (auto conjunction = dynamic_cast<const fs::Conjunction*>(precondition)) {
+		atoms = conjunction->getConjuncts();
+	} else if (auto atom = dynamic_cast<const fs::AtomicFormula*>(precondition)) {
+		atoms.push_back(atom);
+	} else if (!dynamic_cast<const fs::Tautology*>(precondition)) {
+		return nullptr;
+	}
+
+	std::unique_ptr<DirectTableCSP> csp(new DirectTableCSP());
+	for (const fs::AtomicFormula* atom:atoms) {
+		if (!csp->compile(atom, info)) return nullptr;
+	}
+
+	for (const fs::ActionEffect* effect:effects) {
+		if (!dynamic_cast<const fs::StateVariable*>(effect->lhs()) || effect->rhs()->nestedness() > 0) return nullptr;
+		std::set<VariableIdx> scope;
+		fs::ScopeUtils::computeDirectScope(effect->rhs(), scope);
+		for (VariableIdx variable:scope) {
+			if (info.isPredicativeVariable(variable)) return nullptr;
+			csp->add_variable(variable, info);
+		}
+	}
+
+	for (unsigned i = 0; i < csp->_variables.size(); ++i) {
+		std::vector<TupleIdx> tuples;
+		for (ObjectIdx value:csp->_values[i]) tuples.push_back(tuple_index.to_index(csp->_variables[i], value));
+		csp->_tuples.push_back(std::move(tuples));
+	}
+
+	csp->_checks.resize(csp->_variables.size());
+	for (const Table& table:csp->_tables) {
+		unsigned last = *std::max_element(table.scope.begin(), table.scope.end());
+		csp->_checks[last].push_back(&table);
+	}
+	return csp;
+}
+
+unsigned DirectTableCSP::add_variable(VariableIdx variable, const ProblemInfo& info) {
+	auto it = std::find(_variables.begin(), _variables.end(), variable);
+	if (it != _variables.end()) return it - _variables.begin();
+
+	_variables.push_back(variable);
+	// For predicative variables we only care about the (non-negated) atom, as only these are tracked in the RPG
+	_values.push_back(info.isPredicativeVariable(variable) ? ObjectIdxVector{1} : info.getVariableObjects(variable));
+	_unary.push_back(Bitset(_values.back().size()).set());
+	return _variables.size() - 1;
+}
+
+bool DirectTableCSP::compile(const fs::AtomicFormula* atom, const ProblemInfo& info) {
+	if (atom->nestedness() > 0) return false;
+
+	std::set<VariableIdx> variables;
+	fs::ScopeUtils::computeDirectScope(atom, variables);
+	if (variables.empty()) return atom->interpret(PartialAssignment()); // A static atom, which should have been simplified away already
+
+	// Predicative state variables can only appear in atoms such as 'clear(b) = 1', as in the Gecode action CSPs
+	for (VariableIdx variable:variables) {
+		if (!info.isPredicativeVariable(variable)) continue;
+		auto relational = dynamic_cast<const fs::RelationalFormula*>(atom);
+		if (!relational || relational->symbol() != fs::RelationalFormula::Symbol::EQ || !dynamic_cast<const fs::StateVariable*>(relational->lhs())) return false;
+		auto value = dynamic_cast<const fs::IntConstant*>(relational->rhs());
+		if (!value || value->getValue() != 1) return false;
+	}
+
+	std::vector<unsigned> scope;
+	unsigned size = 1;
+	for (VariableIdx variable:variables) {
+		scope.push_back(add_variable(variable, info));
+		size *= _values[scope.back()].size();
+		if (size > MAX_TABLE_SIZE) return false;
+	}
+
+	Table table;
+	table.scope = scope;
+	table.allowed = Bitset(size);
+	unsigned stride = 1;
+	for (unsigned k = 0; k < scope.size(); ++k) {
+		table.strides.push_back(stride);
+		table.supported.push_back(Bitset(_values[scope[k]].size()));
+		stride *= _values[scope[k]].size();
+	}
+
+	// Enumerate all tuples of values of the scope, in mixed-radix order
+	std::vector<unsigned> positions(scope.size(), 0);
+	PartialAssignment assignment;
+	for (unsigned code = 0; code < size; ++code) {
+		for (unsigned k = 0; k < scope.size(); ++k) assignment[_variables[scope[k]]] = _values[scope[k]][positions[k]];
+
+		bool satisfied = false;
+		try { satisfied = atom->interpret(assignment); }
+		catch (const std::out_of_range& e) {} // e.g. the value of some static function being undefined for the given arguments
+
+		if (satisfied) {
+			table.allowed.set(code);
+			table.tuples.push_back(positions);
+		}
+
+		for (unsigned k = 0; k < scope.size(); ++k) { // Increment the mixed-radix counter
+			if (++positions[k] < _values[scope[k]].size()) break;
+			positions[k] = 0;
+		}
+	}
+
+	if (table.tuples.empty()) return false; // An unsatisfiable precondition, which should have been detected when grounding
+
+	if (scope.size() == 1) { // Unary atoms are simply compiled into the mask of allowed values of their variable
+		_unary[scope[0]] &= table.allowed;
+	} else {
+		_tables.push_back(std::move(table));
+	}
+	return true;
+}
+
+void DirectTableCSP::solve(const LayerTest& in_layer, const SolutionCallback& callback) const {
+	std::vector<Bitset> domains(_unary);
+	for (unsigned i = 0; i < domains.size(); ++i) {
+		Bitset& domain = domains[i];
+		for (auto p = domain.find_first(); p != Bitset::npos; p = domain.find_next(p)) {
+			if (!in_layer(_tuples[i][p])) domain.reset(p);
+		}
+		if (domain.none()) return;
+	}
+
+	if (!filter(domains)) return;
+
+	std::vector<unsigned> positions(_variables.size());
+	PartialAssignment assignment;
+	search(0, domains, positions, assignment, callback);
+}
+
+bool DirectTableCSP::filter(std::vector<Bitset>& domains) const {
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (const Table& table:_tables) {
+			std::vector<Bitset>& supported = table.supported;
+			for (Bitset& values:supported) values.reset();
+
+			for (const std::vector<unsigned>& tuple:table.tuples) {
+				bool valid = true;
+				for (unsigned k = 0; k < tuple.size() && valid; ++k) valid = domains[table.scope[k]][tuple[k]];
+				if (!valid) continue;
+				for (unsigned k = 0; k < tuple.size(); ++k) supported[k].set(tuple[k]);
+			}
+
+			// The supported values are a subset of the domain, as only tuples within the domains are considered
+			for (unsigned k = 0; k < table.scope.size(); ++k) {
+				Bitset& domain = domains[table.scope[k]];
+				if (supported[k].none()) return false;
+				if (supported[k] != domain) {
+					domain = supported[k];
+					changed = true;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool DirectTableCSP::search(unsigned depth, const std::vector<Bitset>& domains, std::vector<unsigned>& positions, PartialAssignment& assignment, const SolutionCallback& callback) const {
+	if (depth == _variables.size()) return callback(assignment);
+
+	const Bitset& domain = domains[depth];
+	for (auto p = domain.find_first(); p != Bitset::npos; p = domain.find_next(p)) {
+		positions[depth] = p;
+
+		bool consistent = true;
+		for (const Table* table:_checks[depth]) {
+			unsigned code = 0;
+			for (unsigned k = 0; k < table->scope.size(); ++k) code += positions[table->scope[k]] * table->strides[k];
+			if (!table->allowed[code]) {
+				consistent = false;
+				break;
+			}
+		}
+		if (!consistent) continue;
+
+		assignment[_variables[depth]] = _values[depth][p];
+		if (!search(depth + 1, domains, positions, assignment, callback)) return false;
+	}
+	return true;
+}
+
+} // namespaces
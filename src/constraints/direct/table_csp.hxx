@@ -0,0 +1,104 @@
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <fs_types.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; class AtomicFormula; class Term; class ActionEffect; }}}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class ProblemInfo;
+class TupleIndex;
+
+//! A lightweight solver for the CSPs of ground actions whose precondition is a conjunction of atoms over state variables
+//! (i.e. without nested fluents) and whose effects have a state variable on their LHS and no nested fluent on their RHS.
+//! Every atom of the precondition is compiled (once) into a table with all the tuples of values of its scope that satisfy it.
+//! When solving the CSP on some RPG layer, the domain of each state variable is a bitset over the objects of its type, which
+//! is first made generalized arc-consistent with respect to all tables by simple tabular reduction, and then solutions are
+//! enumerated by backtracking, with the variables and values in increasing order.
+//! The filtering reuses buffers of the object, hence a CSP must not be solved by several threads at the same time.
+class DirectTableCSP {
+public:
+	//! Atoms whose scope has more possible tuples of values than this are not compiled, and the action is not supported
+	static const unsigned MAX_TABLE_SIZE = 1 << 16;
+
+	//! A test of whether the atom with the given tuple index belongs to the RPG layer on which the CSP is being solved
+	typedef std::function<bool (TupleIdx)> LayerTest;
+
+	//! A callback invoked for every solution of the CSP, which returns false if no more solutions are needed
+	typedef std::function<bool (const PartialAssignment&)> SolutionCallback;
+
+	//! Factory method - returns a null pointer if the given precondition or effects are not supported
+	static std::unique_ptr<DirectTableCSP> create(const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects,
+												  const TupleIndex& tuple_index, const ProblemInfo& info);
+
+	~DirectTableCSP() = default;
+	DirectTableCSP(const DirectTableCSP&) = delete;
+	DirectTableCSP& operator=(const DirectTableCSP&) = delete;
+
+	//! Solves the CSP on the layer given by 'in_layer', invoking the given callback on each solution
+	void solve(const LayerTest& in_layer, const SolutionCallback& callback) const;
+
+	//! The state variables of the CSP
+	const std::vector<VariableIdx>& getVariables() const { return _variables; }
+
+protected:
+	typedef boost::dynamic_bitset<> Bitset;
+
+	//! A (compiled) atom of arity higher than one
+	struct Table {
+		//! The (indexes of the) CSP variables of the atom
+		std::vector<unsigned> scope;
+
+		//! The tuples of positions of values that satisfy the atom
+		std::vector<std::vector<unsigned>> tuples;
+
+		//! The same tuples, as a bitset indexed by the mixed-radix encoding of each tuple
+		Bitset allowed;
+
+		//! The radix of each CSP variable of the scope in the mixed-radix encoding
+		std::vector<unsigned> strides;
+
+		//! The values of each CSP variable of the scope supported by some tuple, as computed by 'filter', which
+		//! only needs to clear them on each call
+		mutable std::vector<Bitset> supported;
+	};
+
+	DirectTableCSP() = default;
+
+	//! The state variables of the CSP
+	std::vector<VariableIdx> _variables;
+
+	//! The possible values of each CSP variable, and the tuple index of the corresponding atom
+	std::vector<ObjectIdxVector> _values;
+	std::vector<std::vector<TupleIdx>> _tuples;
+
+	//! The positions of the values of each CSP variable allowed by the unary atoms of the precondition
+	std::vector<Bitset> _unary;
+
+	std::vector<Table> _tables;
+
+	//! _checks[i] contains the tables whose scope is fully assigned once the i-th CSP variable has been assigned
+	std::vector<std::vector<const Table*>> _checks;
+
+	//! Registers the given state variable as a CSP variable, if it was not already, and returns its index
+	unsigned add_variable(VariableIdx variable, const ProblemInfo& info);
+
+	//! Compiles the given atom into a unary mask or a table. Returns false if it is not supported.
+	bool compile(const fs::AtomicFormula* atom, const ProblemInfo& info);
+
+	//! Prunes the given domains until they are generalized arc-consistent wrt all the tables. Returns false if some domain becomes empty.
+	bool filter(std::vector<Bitset>& domains) const;
+
+	//! Recursively enumerates all the solutions extending the assignment of the first 'depth' CSP variables.
+	//! Returns false if the enumeration must stop.
+	bool search(unsigned depth, const std::vector<Bitset>& domains, std::vector<unsigned>& positions, PartialAssignment& assignment, const SolutionCallback& callback) const;
+};
+
+} // namespaces
@@ -33,7 +33,9 @@ ExtensionHandler::ExtensionHandler(const TupleIndex& tuple_index, std::vector<bo
 	_info(ProblemInfo::getInstance()),
 	_tuple_index(tuple_index),
 	_extensions(std::vector<Extension>(_info.getNumLogicalSymbols(), Extension(_tuple_index))), // Reset the whole vector
-	_managed(managed)
+	_managed(managed),
+	_modified(),
+	_is_modified(_info.getNumLogicalSymbols(), false)
 {}
 
 void ExtensionHandler::reset() {
@@ -42,7 +44,15 @@ void ExtensionHandler::reset() {
 }
 
 void ExtensionHandler::advance() {
-// 	_modified.clear(); // Initially all symbols are untouched
+	// Initially all symbols are untouched
+	for (unsigned symbol:_modified) _is_modified[symbol] = false;
+	_modified.clear();
+}
+
+void ExtensionHandler::mark_modified(unsigned symbol) {
+	if (_is_modified[symbol]) return;
+	_is_modified[symbol] = true;
+	_modified.push_back(symbol);
 }
 
 TupleIdx ExtensionHandler::process_atom(VariableIdx variable, ObjectIdx value) {
@@ -51,12 +61,12 @@ TupleIdx ExtensionHandler::process_atom(VariableIdx variable, ObjectIdx value) {
 	bool managed = _managed.at(symbol);
 	bool is_predicate = _info.isPredicativeVariable(variable); // TODO - MOVE FROM PROBLEM INFO INTO SOME PERFORMANT INDEX
 	Extension& extension = _extensions.at(symbol);
-// 	_modified.insert(symbol);  // Mark the extension as modified
 	
 	if (is_predicate && value == 1) {
 		TupleIdx index = _tuple_index.to_index(tuple_data);
 		if (managed) {
 			extension.add_tuple(index);
+			mark_modified(symbol);
 		}
 		return index;
 	}
@@ -67,6 +77,7 @@ TupleIdx ExtensionHandler::process_atom(VariableIdx variable, ObjectIdx value) {
 		TupleIdx index = _tuple_index.to_index(symbol, tuple);
 		if (managed) {
 			extension.add_tuple(index);
+			mark_modified(symbol);
 		}
 		return index;
 	}
@@ -76,9 +87,9 @@ TupleIdx ExtensionHandler::process_atom(VariableIdx variable, ObjectIdx value) {
 
 void ExtensionHandler::process_tuple(TupleIdx tuple) {
 	unsigned symbol = _tuple_index.symbol(tuple);
-// 	_modified.insert(symbol_idx);  // Mark the extension as modified
 	if (_managed.at(symbol)) {
 		_extensions.at(symbol).add_tuple(tuple);
+		mark_modified(symbol);
 	}
 }
 
@@ -101,6 +112,18 @@ std::vector<Gecode::TupleSet> ExtensionHandler::generate_extensions() const {
 	return result;
 }
 
+void ExtensionHandler::update_extensions(std::vector<Gecode::TupleSet>& extensions) const {
+	if (extensions.empty()) {
+		extensions = generate_extensions();
+		return;
+	}
+	assert(extensions.size() == _extensions.size());
+	// Only managed symbols are ever marked as modified
+	for (unsigned symbol:_modified) {
+		extensions[symbol] = generate_extension(symbol);
+	}
+}
+
 Gecode::TupleSet ExtensionHandler::generate_extension(unsigned symbol) const {
 	auto& generator = _extensions[symbol];
 	return generator.generate();
@@ -37,8 +37,14 @@ protected:
 	//! _managed[i] tells us whether we need to manage the extension of logical symbol 'i' or not.
 	std::vector<bool> _managed;
 	
-	//! _modified[i] is true iff the denotation of logical symbol 'i' changed on the last layer
-// 	std::set<unsigned> _modified;
+	//! The logical symbols whose denotation changed on the last layer, in no particular order
+	std::vector<unsigned> _modified;
+	
+	//! _is_modified[i] is true iff the denotation of logical symbol 'i' changed on the last layer
+	std::vector<bool> _is_modified;
+	
+	void mark_modified(unsigned symbol);
+	
 public:
 	ExtensionHandler(const TupleIndex& tuple_index, std::vector<bool> managed);
 	
@@ -60,10 +66,14 @@ public:
 	
 	void advance();
 	
-// 	const std::set<unsigned>& get_modified_symbols() const { return _modified; }
+	const std::vector<unsigned>& get_modified_symbols() const { return _modified; }
 	
 	std::vector<Gecode::TupleSet> generate_extensions() const;
 	
+	//! Regenerates, in the given vector of extensions of the previous layer, only the extensions of the symbols modified
+	//! in the last layer; the rest are left untouched. If the vector is empty, all extensions are generated.
+	void update_extensions(std::vector<Gecode::TupleSet>& extensions) const;
+	
 	Gecode::TupleSet generate_extension(unsigned symbol_id) const;
 };
 
@@ -57,8 +57,15 @@ bool BaseActionCSP::init(bool use_novelty_constraint) {
 
 
 void BaseActionCSP::process(RPGIndex& graph) const {
+	if (!graph.is_first_layer() && !relevant_changes(graph)) {
+		LPT_EDEBUG("heuristic", "Skipping action " << get_action() << ", whose CSP has not changed since the previous layer");
+		return;
+	}
 	log();
-	
+	solve_layer(graph);
+}
+
+void BaseActionCSP::solve_layer(RPGIndex& graph) const {
 	GecodeCSP* csp = instantiate(graph);
 
 	if (!csp || !csp->checkConsistency()) { // This colaterally enforces propagation of constraints
@@ -161,6 +168,30 @@ void BaseActionCSP::index_scopes() {
 	if (_has_nested_lhs) {
 		effect_lhs_variables = {}; // Just in case
 	}
+	
+	// Index the components of the RPG layer on which the instantiations of the CSP depend
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	for (const auto& it:_translator.getAllInputVariables()) {
+		_relevant_variables.push_back(it.first);
+	}
+	for (const ExtensionalConstraint& constraint:_extensional_constraints) {
+		const fs::FluentHeadedNestedTerm* term = constraint.get_term();
+		if (term->getSubterms().empty()) { // 0-ary predicates are checked against the domain of their only state variable
+			_relevant_variables.push_back(info.resolveStateVariable(term->getSymbolId(), {}));
+		} else {
+			_relevant_symbols.push_back(term->getSymbolId());
+		}
+	}
+}
+
+bool BaseActionCSP::relevant_changes(const RPGIndex& graph) const {
+	for (VariableIdx variable:_relevant_variables) {
+		if (graph.changed_in_current_layer(variable)) return true;
+	}
+	for (unsigned symbol:_relevant_symbols) {
+		if (graph.symbol_changed_in_current_layer(symbol)) return true;
+	}
+	return false;
 }
 
 
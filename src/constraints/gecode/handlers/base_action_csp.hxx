@@ -22,7 +22,9 @@ public:
 	//! Returns false iff the induced CSP is inconsistent, i.e. the action is not applicable
 	virtual bool init(bool use_novelty_constraint);
 
-	//!
+	//! Processes the action CSP on the current layer of the given graph, adding to it any newly-reached tuple.
+	//! Must be invoked on every layer of the graph, as actions whose relevant state variable domains and symbol extensions
+	//! did not change since the previous layer are skipped: their CSP is the same, and so are the tuples it can reach.
 	virtual void process(RPGIndex& graph) const;
 
 	//! Initialize the value selector of the underlying CSPs
@@ -77,6 +79,16 @@ protected:
 	
 	std::set<VariableIdx> _action_support;
 	
+	//! The state variables whose domains, and the logical symbols whose extensions, are posted in the instantiations of the CSP
+	std::vector<VariableIdx> _relevant_variables;
+	std::vector<unsigned> _relevant_symbols;
+	
+	//! Whether some state variable domain or symbol extension relevant to the CSP changed in the current layer of the given graph
+	bool relevant_changes(const RPGIndex& graph) const;
+	
+	//! Solves the action CSP on the current layer of the given graph, adding to it any newly-reached tuple
+	virtual void solve_layer(RPGIndex& graph) const;
+	
 	// Constraint registration methods
 	void registerEffectConstraints(const fs::ActionEffect* effect);
 	
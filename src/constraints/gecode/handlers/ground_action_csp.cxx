@@ -1,9 +1,12 @@
 
-#include <languages/fstrips/effects.hxx>
+#include <languages/fstrips/language.hxx>
 #include <constraints/gecode/handlers/ground_action_csp.hxx>
 #include <aptk2/tools/logging.hxx>
 #include <actions/actions.hxx>
 #include <actions/action_id.hxx>
+#include <constraints/direct/table_csp.hxx>
+#include <heuristics/relaxed_plan/rpg_index.hxx>
+#include <problem_info.hxx>
 
 
 namespace fs0 { namespace gecode {
@@ -27,7 +30,7 @@ std::vector<std::shared_ptr<BaseActionCSP>> GroundActionCSP::create(const std::v
 
 // If no set of effects is provided, we'll take all of them into account
 GroundActionCSP::GroundActionCSP(const GroundAction& action, const TupleIndex& tuple_index, bool approximate, bool use_effect_conditions)
-	:  BaseActionCSP(tuple_index, approximate, use_effect_conditions), _action(action)
+	:  BaseActionCSP(tuple_index, approximate, use_effect_conditions), _action(action), _native(nullptr), _constant_effects(true)
 {
 	// Filter out delete effects
 	for (const fs::ActionEffect* effect:_action.getEffects()) {
@@ -36,6 +39,52 @@ GroundActionCSP::GroundActionCSP(const GroundAction& action, const TupleIndex& t
 	}
 }
 
+GroundActionCSP::~GroundActionCSP() = default;
+
+bool GroundActionCSP::init(bool use_novelty_constraint) {
+	if (!BaseActionCSP::init(use_novelty_constraint)) return false;
+	if (_approximate || _use_effect_conditions) return true;
+	
+	_native = DirectTableCSP::create(get_precondition(), get_effects(), _tuple_index, ProblemInfo::getInstance());
+	for (const fs::ActionEffect* effect:get_effects()) {
+		_constant_effects = _constant_effects && dynamic_cast<const fs::Constant*>(effect->rhs());
+	}
+	LPT_DEBUG("main", "Action " << _action << (_native ? " will" : " will not") << " be processed with a native table CSP");
+	return true;
+}
+
+void GroundActionCSP::solve_layer(RPGIndex& graph) const {
+	if (!_native) return BaseActionCSP::solve_layer(graph);
+	
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const auto& effects = get_effects();
+	
+	// The CSP is solved against the atoms of the current layer only, as the Gecode CSPs are
+	auto in_layer = [&graph](TupleIdx tuple) { return graph.reached_before_current_layer(tuple); };
+	
+	_native->solve(in_layer, [&](const PartialAssignment& assignment) {
+		for (unsigned i = 0; i < effects.size(); ++i) {
+			const fs::ActionEffect* effect = effects[i];
+			ObjectIdx value = effect->rhs()->interpret(assignment);
+			if (info.isBoundedType(effect->lhs()->getType())) {
+				const auto& bounds = effect->lhs()->getBounds();
+				if (value < bounds.first || value > bounds.second) continue;
+			}
+			
+			TupleIdx tuple = _tuple_index.to_index(effect_lhs_variables[i], value);
+			if (graph.reached(tuple)) continue;
+			
+			std::vector<TupleIdx> support;
+			for (VariableIdx variable:effect_support_variables[i]) {
+				support.push_back(_tuple_index.to_index(variable, assignment.at(variable)));
+			}
+			support.insert(support.end(), _necessary_tuples.begin(), _necessary_tuples.end());
+			graph.add(tuple, get_action_id(nullptr), std::move(support));
+		}
+		return !_constant_effects;
+	});
+}
+
 const fs::Formula* GroundActionCSP::get_precondition() const {
 	return _action.getPrecondition();
 }
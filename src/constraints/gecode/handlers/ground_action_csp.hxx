@@ -6,6 +6,7 @@
 
 namespace fs0 {
 class GroundAction;
+class DirectTableCSP;
 }
 
 namespace fs0 { namespace gecode {
@@ -19,7 +20,10 @@ public:
 
 	//! Constructors / Destructor
 	GroundActionCSP(const GroundAction& action, const TupleIndex& tuple_index, bool approximate, bool use_effect_conditions);
-	virtual ~GroundActionCSP() {}
+	virtual ~GroundActionCSP();
+	
+	//! Besides the Gecode CSP, compiles the action into a native table CSP whenever it is supported
+	bool init(bool use_novelty_constraint) override;
 	
 	const GroundAction& get_action() const override { return _action; }
 	
@@ -32,9 +36,18 @@ protected:
 	const GroundAction& _action;
 	
 	std::vector<const fs::ActionEffect*> _add_effects;
+	
+	//! The native table CSP of the action, if its precondition and effects are simple enough, or null otherwise
+	std::unique_ptr<DirectTableCSP> _native;
+	
+	//! Whether all effects have a constant RHS, in which case a single solution of the CSP is enough
+	bool _constant_effects;
 
 	const ActionID* get_action_id(const GecodeCSP* solution) const override;
 	
+	//! Actions compiled into a native table CSP are solved without Gecode
+	void solve_layer(RPGIndex& graph) const override;
+	
 	//! Log some handler-related into
 	virtual void log() const override;
 };
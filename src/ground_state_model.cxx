@@ -4,9 +4,27 @@
 #include <state.hxx>
 #include <applicability/formula_interpreter.hxx>
 #include <actions/ground_action_iterator.hxx>
+#include <applicability/successor_generator.hxx>
+#include <applicability/incremental_applicability.hxx>
 
 namespace fs0 {
 
+GroundStateModel::GroundStateModel(const Problem& problem, bool incremental) :
+	task(problem),
+	_tracker(incremental ? new IncrementalApplicabilityTracker(problem) : nullptr),
+	_stop(nullptr)
+{}
+
+GroundStateModel::~GroundStateModel() = default;
+
+GroundStateModel::GroundStateModel(const GroundStateModel& other) :
+	task(other.task),
+	_tracker(other._tracker ? new IncrementalApplicabilityTracker(*other._tracker) : nullptr),
+	_stop(other._stop)
+{}
+
+GroundStateModel::GroundStateModel(GroundStateModel&& other) = default;
+
 State GroundStateModel::init() const {
 	// We need to make a copy so that we can return it as non-const.
 	// Ugly, but this way we make it fit the search engine interface without further changes,
@@ -23,8 +41,10 @@ State GroundStateModel::next(const State& state, const GroundAction::IdType& act
 } 
 
 State GroundStateModel::next(const State& state, const GroundAction& a) const { 
-	ApplicabilityManager manager(task.getStateConstraints());
-	return State(state, manager.computeEffects(state, a)); // Copy everything into the new state and apply the changeset
+	// Copy everything into the new state and apply the changeset, reusing the effects computed when checking applicability, if possible.
+	State next = ApplicabilityManager::computeSuccessor(state, a);
+	if (_tracker) _tracker->derive(state, ApplicabilityManager::computeScratchEffects(state, a), next);
+	return next;
 }
 
 void GroundStateModel::print(std::ostream& os) const {
@@ -32,7 +52,11 @@ void GroundStateModel::print(std::ostream& os) const {
 }
 
 GroundAction::ApplicableSet GroundStateModel::applicable_actions(const State& state) const {
-	return GroundActionIterator(ApplicabilityManager(task.getStateConstraints()), state, task.getGroundActions());
+	if (_stop && _stop->load(std::memory_order_relaxed)) throw SearchInterrupted();
+	if (_tracker) {
+		return GroundActionIterator(ApplicabilityManager(task.getStateConstraints()), task.getSuccessorGenerator(), state, task.getGroundActions(), _tracker->expand(state));
+	}
+	return GroundActionIterator(ApplicabilityManager(task.getStateConstraints()), task.getSuccessorGenerator(), state, task.getGroundActions());
 }
 
 } // namespaces
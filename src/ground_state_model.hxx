@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include <memory>
+#include <atomic>
+#include <stdexcept>
+
 #include <aptk2/search/interfaces/det_state_model.hxx>
 #include <actions/actions.hxx>
 
@@ -8,16 +12,25 @@ namespace fs0 {
 
 class Problem;
 class State;
+class IncrementalApplicabilityTracker;
+
+//! Thrown by a model whose stop flag has been set, as the search engines offer no other way of being interrupted
+class SearchInterrupted : public std::runtime_error {
+public:
+	SearchInterrupted() : std::runtime_error("The search was interrupted") {}
+};
 
 class GroundStateModel : public aptk::DetStateModel<State, GroundAction> {
 public:
-	GroundStateModel(const Problem& problem) : task(problem) {}
-	~GroundStateModel() = default;
+	//! If 'incremental' is true, the applicable actions of each state are derived incrementally from those of its parent
+	GroundStateModel(const Problem& problem, bool incremental = false);
+	~GroundStateModel();
 	
-	GroundStateModel(const GroundStateModel& other) = default;
-	GroundStateModel& operator=(const GroundStateModel& other) = default;
-	GroundStateModel(GroundStateModel&& other) = default;
-	GroundStateModel& operator=(GroundStateModel&& rhs) = default;
+	//! Each copy of the model gets its own incremental applicability tracker, as e.g. the parallel drivers use a copy per thread
+	GroundStateModel(const GroundStateModel& other);
+	GroundStateModel& operator=(const GroundStateModel& other) = delete;
+	GroundStateModel(GroundStateModel&& other);
+	GroundStateModel& operator=(GroundStateModel&& rhs) = delete;
 
 	//! Returns initial state of the problem
 	State init() const;
@@ -35,10 +48,20 @@ public:
 	void print(std::ostream &os) const;
 	
 	const Problem& getTask() const { return task; }
+	
+	//! Once the given flag is set, the next state expanded through the model throws a SearchInterrupted exception
+	void set_stop_flag(const std::atomic<bool>* stop) { _stop = stop; }
+	const std::atomic<bool>* get_stop_flag() const { return _stop; }
 
 protected:
 	// The underlying planning problem.
 	const Problem& task;
+	
+	//! The incremental applicability tracker, if incremental applicability is enabled
+	std::unique_ptr<IncrementalApplicabilityTracker> _tracker;
+	
+	//! The flag that signals that the search must stop, if any
+	const std::atomic<bool>* _stop;
 };
 
 } // namespaces
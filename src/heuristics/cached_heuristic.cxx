@@ -0,0 +1,11 @@
+
+#include <heuristics/cached_heuristic.hxx>
+
+namespace fs0 {
+
+HeuristicCacheStats& HeuristicCacheStats::instance() {
+	static HeuristicCacheStats theInstance;
+	return theInstance;
+}
+
+} // namespaces
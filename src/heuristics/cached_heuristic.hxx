@@ -0,0 +1,121 @@
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include <state.hxx>
+
+namespace fs0 {
+
+//! Process-wide (singleton) counters of the lookups performed on all heuristic caches, so that they can be reported
+//! together with the rest of the search statistics. Several caches might update them concurrently.
+class HeuristicCacheStats {
+public:
+	static HeuristicCacheStats& instance();
+
+	HeuristicCacheStats(const HeuristicCacheStats&) = delete;
+	HeuristicCacheStats& operator=(const HeuristicCacheStats&) = delete;
+
+	void hit() { _hits.fetch_add(1, std::memory_order_relaxed); }
+	void miss() { _misses.fetch_add(1, std::memory_order_relaxed); }
+
+	unsigned long hits() const { return _hits; }
+	unsigned long misses() const { return _misses; }
+
+	//! Whether any heuristic cache has been used at all
+	bool used() const { return hits() + misses() > 0; }
+
+protected:
+	HeuristicCacheStats() : _hits(0), _misses(0) {}
+
+	std::atomic<unsigned long> _hits;
+	std::atomic<unsigned long> _misses;
+};
+
+//! A heuristic decorator that caches the heuristic values of (at most) 'capacity' states, evicting entries according
+//! to the clock (second-chance) policy when full. Entries are looked up by the hash of the state and then verified
+//! against the full state, so that hash collisions can never return the value of a different state.
+//! A capacity of 0 disables the cache, in which case evaluations are simply forwarded to the underlying heuristic.
+template <typename HeuristicT>
+class CachedHeuristic {
+public:
+	CachedHeuristic(HeuristicT&& heuristic, unsigned capacity) :
+		_heuristic(std::move(heuristic)), _capacity(capacity), _entries(), _index(), _hand(0)
+	{
+		_entries.reserve(_capacity);
+		_index.reserve(_capacity);
+	}
+
+	~CachedHeuristic() = default;
+	CachedHeuristic(const CachedHeuristic&) = delete;
+	CachedHeuristic(CachedHeuristic&&) = default;
+	CachedHeuristic& operator=(const CachedHeuristic&) = delete;
+	CachedHeuristic& operator=(CachedHeuristic&&) = default;
+
+	long evaluate(const State& state) {
+		if (_capacity == 0) return _heuristic.evaluate(state);
+
+		auto it = _index.find(state.hash());
+		if (it != _index.end()) {
+			Entry& entry = _entries[it->second];
+			if (entry.state == state) {
+				HeuristicCacheStats::instance().hit();
+				entry.referenced = true;
+				return entry.h;
+			}
+		}
+
+		HeuristicCacheStats::instance().miss();
+		long h = _heuristic.evaluate(state);
+
+		if (it != _index.end()) { // A hash collision: the new state simply takes the slot of the colliding one
+			_entries[it->second] = Entry{state, h, true};
+		} else if (_entries.size() < _capacity) {
+			_index.insert(std::make_pair(state.hash(), _entries.size()));
+			_entries.push_back(Entry{state, h, true});
+		} else {
+			unsigned slot = evict();
+			_entries[slot] = Entry{state, h, true};
+			_index.insert(std::make_pair(state.hash(), slot));
+		}
+		return h;
+	}
+
+	//! The decorated heuristic
+	HeuristicT& getHeuristic() { return _heuristic; }
+
+protected:
+	struct Entry {
+		State state;
+		long h;
+		bool referenced;
+	};
+
+	HeuristicT _heuristic;
+
+	unsigned _capacity;
+
+	std::vector<Entry> _entries;
+
+	//! Maps the hash of each cached state to its slot in the vector of entries
+	std::unordered_map<std::size_t, unsigned> _index;
+
+	//! The clock hand, i.e. the next slot to consider for eviction
+	unsigned _hand;
+
+	//! Frees the slot of the first entry not referenced since the last pass of the clock hand, and returns it
+	unsigned evict() {
+		while (_entries[_hand].referenced) {
+			_entries[_hand].referenced = false;
+			_hand = (_hand + 1) % _capacity;
+		}
+		unsigned slot = _hand;
+		_hand = (_hand + 1) % _capacity;
+		_index.erase(_entries[slot].state.hash());
+		return slot;
+	}
+};
+
+} // namespaces
@@ -0,0 +1,75 @@
+
+#include <cassert>
+
+#include <heuristics/novelty/bit_novelty_tables.hxx>
+
+namespace fs0 {
+
+bool BitNoveltyTables::is_applicable(const std::vector<std::pair<int, int>>& bounds, unsigned max_novelty) {
+	if (max_novelty < 1 || max_novelty > 2) return false;
+	uint64_t width = 0;
+	for (const auto& b:bounds) {
+		if (b.first > b.second) return false;
+		width += (uint64_t) ((int64_t) b.second - b.first + 1);
+	}
+	if (width > MAX_WIDTH) return false;
+	return max_novelty < 2 || width * width / 2 <= MAX_PAIR_BITS;
+}
+
+BitNoveltyTables::BitNoveltyTables(const std::vector<std::pair<int, int>>& bounds, unsigned max_novelty) :
+	_max_novelty(max_novelty), _offsets(), _lower(), _seen1(), _seen2(), _positions(bounds.size())
+{
+	assert(is_applicable(bounds, max_novelty));
+	unsigned width = 0;
+	for (const auto& b:bounds) {
+		_offsets.push_back(width);
+		_lower.push_back(b.first);
+		width += b.second - b.first + 1;
+	}
+	_offsets.push_back(width);
+
+	_seen1.resize(num_words(width), 0);
+	if (_max_novelty > 1) _seen2.resize(width);
+}
+
+unsigned BitNoveltyTables::evaluate(const std::vector<int>& values) {
+	unsigned num_features = values.size();
+	assert(num_features == _positions.size());
+
+	// Compute the position of every (feature, value) pair only once
+	for (unsigned f = 0; f < num_features; ++f) {
+		unsigned position = _offsets[f] + (values[f] - _lower[f]);
+		assert(position < _offsets[f + 1]);
+		_positions[f] = position;
+	}
+
+	bool new_atom = false;
+	for (unsigned position:_positions) {
+		Word& word = _seen1[position / 64];
+		new_atom = new_atom || !(word & bit(position));
+		word |= bit(position);
+	}
+	unsigned novelty = new_atom ? 1 : _max_novelty + 1;
+
+	if (_max_novelty > 1) {
+		unsigned width = _offsets.back();
+		Word fresh = 0;
+		for (unsigned f = 0; f + 1 < num_features; ++f) {
+			unsigned first = _offsets[f + 1];
+			std::vector<Word>& row = _seen2[_positions[f]];
+			if (row.empty()) row.resize(num_words(width - first), 0);
+
+			for (unsigned g = f + 1; g < num_features; ++g) {
+				unsigned position = _positions[g] - first;
+				Word& word = row[position / 64];
+				fresh |= ~word & bit(position);
+				word |= bit(position);
+			}
+		}
+		if (fresh && novelty > 2) novelty = 2;
+	}
+
+	return novelty;
+}
+
+} // namespaces
@@ -0,0 +1,60 @@
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fs0 {
+
+//! Dense novelty tables for novelty bounds 1 and 2, over features whose values range over known, finite intervals.
+//! Every (feature, value) pair is mapped to a position in [0, W), where W is the sum of the sizes of the feature domains,
+//! so that the valuation of a state becomes the set of positions of its F features.
+//! - The width-1 table is a bitset of W bits with the pairs seen so far.
+//! - The width-2 table has one row of bits per (feature, value) pair p, with the pairs of the features after that of p
+//!   that have been seen together with p. Evaluating a state tests and sets only the F(F-1)/2 bits of its own pairs of positions.
+//!   Rows are only allocated when first needed, but since they might take up to W^2/2 bits, the width-2 table is only
+//!   used when that amount fits within a fixed memory budget.
+class BitNoveltyTables {
+public:
+	typedef uint64_t Word;
+
+	//! The maximum number of (feature, value) pairs for which the tables can be used
+	static const unsigned MAX_WIDTH = 1 << 24;
+
+	//! The maximum number of bits that the width-2 table might take, i.e. 256MB
+	static const uint64_t MAX_PAIR_BITS = uint64_t(1) << 31;
+
+	//! Whether the tables can be used for features with the given (inclusive) bounds and the given novelty bound
+	static bool is_applicable(const std::vector<std::pair<int, int>>& bounds, unsigned max_novelty);
+
+	BitNoveltyTables() : _max_novelty(0) {}
+	BitNoveltyTables(const std::vector<std::pair<int, int>>& bounds, unsigned max_novelty);
+
+	//! Returns the novelty of the given valuation of the features, i.e. the size of the smallest tuple of (feature, value) pairs
+	//! that had not been seen before, or 'max_novelty + 1' if there is none, and registers all its tuples as seen
+	unsigned evaluate(const std::vector<int>& values);
+
+protected:
+	unsigned _max_novelty;
+
+	//! The position of the first value of each feature, plus the total width W as the last element
+	std::vector<unsigned> _offsets;
+
+	//! The lower bound of each feature
+	std::vector<int> _lower;
+
+	std::vector<Word> _seen1;
+
+	//! The row of position 'p' of feature 'f' covers the positions of the features after 'f', i.e. its bit 'i'
+	//! stands for position '_offsets[f+1] + i'
+	std::vector<std::vector<Word>> _seen2;
+
+	//! The positions of the valuation being evaluated
+	std::vector<unsigned> _positions;
+
+	static unsigned num_words(unsigned bits) { return (bits + 63) / 64; }
+	static Word bit(unsigned position) { return Word(1) << (position % 64); }
+};
+
+} // namespaces
@@ -1,11 +1,19 @@
 
 #include <heuristics/novelty/features.hxx>
 #include <state.hxx>
+#include <problem_info.hxx>
 
 namespace fs0 {
 
 aptk::ValueIndex StateVariableFeature::evaluate( const State& s ) const { return s.getValue(_variable); }
 
+std::pair<int, int> StateVariableFeature::bounds() const {
+	const ObjectIdxVector& values = ProblemInfo::getInstance().getVariableObjects(_variable);
+	if (values.empty()) return std::make_pair(1, 0); // An empty interval
+	const auto minmax = std::minmax_element(values.begin(), values.end());
+	return std::make_pair(*minmax.first, *minmax.second);
+}
+
 aptk::ValueIndex ConditionSetFeature::evaluate( const State& s ) const {
 	aptk::ValueIndex satisfied = 0;
 	for ( const fs::AtomicFormula* c : _conditions ) {
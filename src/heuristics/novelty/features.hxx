@@ -18,6 +18,9 @@ public:
 
 	virtual ~NoveltyFeature() {}
 	virtual aptk::ValueIndex evaluate( const State& s ) const = 0;
+	
+	//! The (inclusive) bounds of the values of the feature
+	virtual std::pair<int, int> bounds() const = 0;
 };
 
 //! A state variable-based feature that simply returs the value of a certain variable in the state
@@ -26,6 +29,7 @@ public:
 	StateVariableFeature( VariableIdx variable ) : _variable(variable) {}
 	~StateVariableFeature() {}
 	aptk::ValueIndex  evaluate( const State& s ) const;
+	std::pair<int, int> bounds() const;
 
 protected:
 	VariableIdx _variable;
@@ -41,6 +45,7 @@ public:
 	void addCondition(const fs::AtomicFormula* condition) { _conditions.push_back(condition); }
 
 	aptk::ValueIndex  evaluate( const State& s ) const;
+	std::pair<int, int> bounds() const { return std::make_pair(0, (int) _conditions.size()); }
 
 protected:
 	std::vector<const fs::AtomicFormula*> _conditions;
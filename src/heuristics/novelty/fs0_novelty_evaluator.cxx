@@ -17,10 +17,37 @@ GenericStateAdapter::GenericStateAdapter( const State& s, const GenericNoveltyEv
 GenericStateAdapter::~GenericStateAdapter() {}
 
 GenericNoveltyEvaluator::GenericNoveltyEvaluator(const Problem& problem, unsigned novelty_bound, const NoveltyFeaturesConfiguration& feature_configuration)
-	: Base()
+	: Base(), _use_tables(false), _tables(), _values(), _num_states(novelty_bound + 2, 0)
 {
 	set_max_novelty(novelty_bound);
 	selectFeatures(problem, feature_configuration);
+	
+	std::vector<std::pair<int, int>> bounds;
+	for (NoveltyFeature::ptr feature:_features) bounds.push_back(feature->bounds());
+	_use_tables = BitNoveltyTables::is_applicable(bounds, novelty_bound);
+	if (_use_tables) {
+		_tables = BitNoveltyTables(bounds, novelty_bound);
+		_values.resize(_features.size());
+	}
+	LPT_INFO("main", "Novelty evaluation: " << (_use_tables ? "dense bit tables" : "generic tables"));
+}
+
+unsigned GenericNoveltyEvaluator::evaluate(const State& s) {
+	if (!_use_tables) {
+		GenericStateAdapter adaptee( s, *this );
+		return evaluate( adaptee );
+	}
+	
+	for (unsigned k = 0; k < _features.size(); ++k) {
+		_values[k] = _features[k]->evaluate(s);
+	}
+	unsigned novelty = _tables.evaluate(_values);
+	++_num_states[novelty];
+	return novelty;
+}
+
+unsigned GenericNoveltyEvaluator::get_num_states(unsigned k) const {
+	return _use_tables ? _num_states.at(k) : Base::get_num_states(k);
 }
 
 GenericNoveltyEvaluator::~GenericNoveltyEvaluator() {
@@ -3,6 +3,7 @@
 
 #include <aptk2/heuristics/novelty/fd_novelty_evaluator.hxx>
 #include <heuristics/novelty/features.hxx>
+#include <heuristics/novelty/bit_novelty_tables.hxx>
 #include <state.hxx>
 #include <problem.hxx>
 
@@ -34,10 +35,10 @@ public:
 	
 	using Base::evaluate; // So that we do not hide the base evaluate(const FiniteDomainNoveltyEvaluator&) method
 	
-	unsigned evaluate( const State& s ) {
-		GenericStateAdapter adaptee( s, *this );
-		return evaluate( adaptee );
-	}
+	unsigned evaluate( const State& s );
+	
+	//! The number of states evaluated so far with novelty 'k'
+	unsigned get_num_states( unsigned k ) const;
 
 	unsigned numFeatures() const { return _features.size(); }
 	NoveltyFeature::ptr feature( unsigned i ) const { return _features[i]; }
@@ -49,6 +50,16 @@ protected:
 	
 	//! An array with all the features that we take into account when computing the novelty
 	std::vector<NoveltyFeature::ptr> _features;
+	
+	//! Whether the dense novelty tables are used instead of the generic ones, see BitNoveltyTables::is_applicable
+	bool _use_tables;
+	BitNoveltyTables _tables;
+	
+	//! The valuation of the features on the state being evaluated
+	std::vector<int> _values;
+	
+	//! '_num_states[k]' is the number of states evaluated with novelty 'k', when using the dense tables
+	std::vector<unsigned> _num_states;
 };
 
 
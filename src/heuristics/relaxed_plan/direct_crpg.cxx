@@ -6,12 +6,13 @@
 #include <heuristics/relaxed_plan/relaxed_plan_extractor.hxx>
 #include <relaxed_state.hxx>
 #include <applicability/formula_interpreter.hxx>
+#include <problem.hxx>
 
 
 namespace fs0 {
 
 DirectCRPG::DirectCRPG(const Problem& problem, std::vector<std::unique_ptr<DirectActionManager>>&& managers, std::shared_ptr<DirectRPGBuilder> builder) :
-	_problem(problem), _managers(std::move(managers)), all_whitelist(managers.size()), _builder(builder)
+	_problem(problem), _managers(std::move(managers)), all_whitelist(_managers.size()), _builder(builder), _bookkeeping(problem.get_tuple_index())
 {
 	LPT_DEBUG("heuristic", "Relaxed Plan heuristic initialized with builder: " << std::endl << *_builder);
     std::iota(all_whitelist.begin(), all_whitelist.end(), 0);
@@ -27,7 +28,8 @@ long DirectCRPG::evaluate(const State& seed, const std::vector<ActionIdx>& white
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 	
 	RelaxedState relaxed(seed);
-	RPGData bookkeeping(seed);
+	RPGData& bookkeeping = _bookkeeping;
+	bookkeeping.reset(seed);
 	
 	LPT_EDEBUG("heuristic", std::endl << "Computing RPG from seed state: " << std::endl << seed << std::endl << "****************************************");
 	
@@ -4,6 +4,7 @@
 #include <fs_types.hxx>
 #include <constraints/direct/direct_rpg_builder.hxx>
 #include <constraints/direct/action_manager.hxx>
+#include <heuristics/relaxed_plan/rpg_data.hxx>
 
 namespace fs0 {
 
@@ -11,7 +12,6 @@ class GroundAction;
 class Problem;
 class State;
 class RelaxedState;
-class RPGData;
 
 class DirectCRPG {
 public:
@@ -48,6 +48,9 @@ protected:
 	
 	//! The RPG building helper
 	const std::shared_ptr<DirectRPGBuilder> _builder;
+	
+	//! The RPG book-keeping data, reused across evaluations
+	RPGData _bookkeeping;
 };
 
 //! The h_max version
@@ -56,6 +59,9 @@ public:
  	DirectCHMax(const Problem& problem, std::vector<std::unique_ptr<DirectActionManager>>&& managers, std::shared_ptr<DirectRPGBuilder> builder);
 	~DirectCHMax() = default;
 	
+	DirectCHMax(const DirectCHMax&) = delete;
+	DirectCHMax(DirectCHMax&&) = default;
+	
 	//! The hmax heuristic only cares about the size of the RP graph.
 	long computeHeuristic(const State& seed, const RelaxedState& state, const RPGData& bookkeeping) override;
 };
@@ -0,0 +1,206 @@
+
+#include <algorithm>
+#include <limits>
+
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
+#include <languages/fstrips/language.hxx>
+#include <actions/actions.hxx>
+#include <utils/tuple_index.hxx>
+#include <problem.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+
+
+namespace fs0 {
+
+static const long INFINITE_COST = std::numeric_limits<long>::max();
+
+PropositionalRPG::Type PropositionalRPG::parse_type(const std::string& name) {
+	if (name == "hff") return Type::HFF;
+	if (name == "hmax") return Type::HMax;
+	if (name == "hadd") return Type::HAdd;
+	throw std::runtime_error("Unknown heuristic type: " + name);
+}
+
+bool PropositionalRPG::collect_atoms(const fs::Formula* formula, const TupleIndex& tuple_index, std::vector<TupleIdx>& tuples) {
+	std::vector<const fs::AtomicFormula*> atoms;
+	if (auto conjunction = dynamic_cast<const fs::Conjunction*>(formula)) {
+		atoms = conjunction->getConjuncts();
+	} else if (auto atom = dynamic_cast<const fs::AtomicFormula*>(formula)) {
+		atoms.push_back(atom);
+	} else if (!formula->is_tautology()) {
+		return false;
+	}
+
+	for (const fs::AtomicFormula* atom:atoms) {
+		auto eq = dynamic_cast<const fs::EQAtomicFormula*>(atom);
+		if (!eq) return false;
+		auto variable = dynamic_cast<const fs::StateVariable*>(eq->lhs());
+		auto value = dynamic_cast<const fs::Constant*>(eq->rhs());
+		if (!variable || !value || value->getValue() != 1) return false; // Negated atoms are not supported
+		tuples.push_back(tuple_index.to_index(variable->getValue(), 1));
+	}
+
+	// Remove repeated atoms, so that the precondition counters are correct
+	std::sort(tuples.begin(), tuples.end());
+	tuples.erase(std::unique(tuples.begin(), tuples.end()), tuples.end());
+	return true;
+}
+
+bool PropositionalRPG::is_supported(const Problem& problem) {
+	if (!problem.is_predicative() || !problem.getStateConstraints()->is_tautology()) return false;
+
+	const TupleIndex& tuple_index = problem.get_tuple_index();
+	std::vector<TupleIdx> tuples;
+	if (!collect_atoms(problem.getGoalConditions(), tuple_index, tuples)) return false;
+
+	for (const GroundAction* action:problem.getGroundActions()) {
+		tuples.clear();
+		if (!collect_atoms(action->getPrecondition(), tuple_index, tuples)) return false;
+		for (const fs::ActionEffect* effect:action->getEffects()) {
+			if (!effect->condition()->is_tautology() || !dynamic_cast<const fs::StateVariable*>(effect->lhs()) || !dynamic_cast<const fs::Constant*>(effect->rhs())) return false;
+		}
+	}
+	return true;
+}
+
+PropositionalRPG::PropositionalRPG(const Problem& problem, Type type) : _type(type) {
+	assert(is_supported(problem));
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const TupleIndex& tuple_index = problem.get_tuple_index();
+	const auto& actions = problem.getGroundActions();
+	unsigned num_tuples = tuple_index.size();
+
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		_variable_tuples.push_back(tuple_index.to_index(variable, 1));
+	}
+
+	std::vector<unsigned> num_triggers(num_tuples, 0);
+	_pre_offsets.push_back(0);
+	_add_offsets.push_back(0);
+	for (ActionIdx idx = 0; idx < actions.size(); ++idx) {
+		const GroundAction& action = *actions[idx];
+		std::vector<TupleIdx> precondition;
+		collect_atoms(action.getPrecondition(), tuple_index, precondition);
+		for (TupleIdx tuple:precondition) ++num_triggers[tuple];
+		if (precondition.empty()) _unconditioned.push_back(idx);
+		_preconditions.insert(_preconditions.end(), precondition.begin(), precondition.end());
+		_pre_offsets.push_back(_preconditions.size());
+
+		for (const fs::ActionEffect* effect:action.getEffects()) {
+			// All effects assign a constant value to a predicative state variable; delete effects are ignored in the relaxation
+			if (dynamic_cast<const fs::Constant*>(effect->rhs())->getValue() == 0) continue;
+			_adds.push_back(tuple_index.to_index(dynamic_cast<const fs::StateVariable*>(effect->lhs())->getValue(), 1));
+		}
+		_add_offsets.push_back(_adds.size());
+	}
+
+	// Build the (tuple -> actions) adjacency lists by counting sort
+	_trigger_offsets.assign(num_tuples + 1, 0);
+	for (TupleIdx tuple = 0; tuple < num_tuples; ++tuple) _trigger_offsets[tuple + 1] = _trigger_offsets[tuple] + num_triggers[tuple];
+	_triggers.resize(_preconditions.size());
+	std::vector<unsigned> next(_trigger_offsets.begin(), _trigger_offsets.end() - 1);
+	for (ActionIdx idx = 0; idx < actions.size(); ++idx) {
+		for (unsigned i = _pre_offsets[idx]; i < _pre_offsets[idx + 1]; ++i) _triggers[next[_preconditions[i]]++] = idx;
+	}
+
+	collect_atoms(problem.getGoalConditions(), tuple_index, _goal);
+	_is_goal.assign(num_tuples, false);
+	for (TupleIdx tuple:_goal) _is_goal[tuple] = true;
+
+	_cost.resize(num_tuples);
+	_supporter.resize(num_tuples);
+	_marked.resize(num_tuples);
+	_unsatisfied.resize(actions.size());
+	_action_cost.resize(actions.size());
+	_in_plan.resize(actions.size());
+}
+
+long PropositionalRPG::evaluate(const State& seed) {
+	std::fill(_cost.begin(), _cost.end(), INFINITE_COST);
+	std::fill(_action_cost.begin(), _action_cost.end(), 0);
+	for (ActionIdx idx = 0; idx < _unsatisfied.size(); ++idx) _unsatisfied[idx] = _pre_offsets[idx + 1] - _pre_offsets[idx];
+	_queue.clear();
+
+	for (VariableIdx variable = 0; variable < _variable_tuples.size(); ++variable) {
+		if (seed.getValue(variable) != 1) continue;
+		TupleIdx tuple = _variable_tuples[variable];
+		_cost[tuple] = 0;
+		_queue.push_back(std::make_pair(0, tuple));
+	}
+	std::make_heap(_queue.begin(), _queue.end(), std::greater<std::pair<long, TupleIdx>>());
+
+	for (ActionIdx action:_unconditioned) apply(action);
+
+	// Tuples are only enqueued when their cost decreases, hence a tuple is expanded only when popped with its final cost
+	unsigned pending_goals = _goal.size();
+	while (!_queue.empty() && pending_goals > 0) {
+		std::pop_heap(_queue.begin(), _queue.end(), std::greater<std::pair<long, TupleIdx>>());
+		long cost = _queue.back().first;
+		TupleIdx tuple = _queue.back().second;
+		_queue.pop_back();
+		if (cost > _cost[tuple]) continue;
+
+		if (_is_goal[tuple]) --pending_goals;
+
+		for (unsigned i = _trigger_offsets[tuple]; i < _trigger_offsets[tuple + 1]; ++i) {
+			ActionIdx action = _triggers[i];
+			_action_cost[action] = (_type == Type::HAdd) ? _action_cost[action] + cost : std::max(_action_cost[action], cost);
+			if (--_unsatisfied[action] == 0) apply(action);
+		}
+	}
+
+	if (pending_goals > 0) return -1;
+
+	if (_type == Type::HFF) return extract_plan();
+
+	long h = 0;
+	for (TupleIdx tuple:_goal) {
+		h = (_type == Type::HAdd) ? h + _cost[tuple] : std::max(h, _cost[tuple]);
+	}
+	return h;
+}
+
+void PropositionalRPG::apply(ActionIdx action) {
+	long cost = _action_cost[action] + 1;
+	for (unsigned i = _add_offsets[action]; i < _add_offsets[action + 1]; ++i) {
+		TupleIdx tuple = _adds[i];
+		if (cost >= _cost[tuple]) continue;
+		_cost[tuple] = cost;
+		_supporter[tuple] = action;
+		_queue.push_back(std::make_pair(cost, tuple));
+		std::push_heap(_queue.begin(), _queue.end(), std::greater<std::pair<long, TupleIdx>>());
+	}
+}
+
+long PropositionalRPG::extract_plan() {
+	std::fill(_in_plan.begin(), _in_plan.end(), false);
+	std::fill(_marked.begin(), _marked.end(), false);
+	_open.clear();
+	for (TupleIdx tuple:_goal) {
+		_marked[tuple] = true;
+		_open.push_back(tuple);
+	}
+
+	long num_actions = 0;
+	while (!_open.empty()) {
+		TupleIdx tuple = _open.back();
+		_open.pop_back();
+		if (_cost[tuple] == 0) continue; // The atom is true in the seed state
+
+		ActionIdx action = _supporter[tuple];
+		if (_in_plan[action]) continue;
+		_in_plan[action] = true;
+		++num_actions;
+
+		for (unsigned i = _pre_offsets[action]; i < _pre_offsets[action + 1]; ++i) {
+			TupleIdx precondition = _preconditions[i];
+			if (_marked[precondition]) continue;
+			_marked[precondition] = true;
+			_open.push_back(precondition);
+		}
+	}
+	return num_actions;
+}
+
+} // namespaces
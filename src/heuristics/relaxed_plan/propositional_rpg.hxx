@@ -0,0 +1,86 @@
+
+#pragma once
+
+#include <string>
+
+#include <fs_types.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Formula; }}}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class Problem;
+class State;
+class TupleIndex;
+
+//! A delete-relaxation heuristic for STRIPS-like problems, i.e. problems where all symbols are predicates, all action
+//! preconditions and the goal are conjunctions of positive atoms, and there are no conditional effects nor state constraints.
+//! Actions are compiled once into flat arrays of tuple indexes, and each evaluation runs a generalized Dijkstra over
+//! the tuples, with one counter of unsatisfied preconditions per action, computing h_max or h_add, and, in the case of h_FF,
+//! extracting a relaxed plan from the best (h_max) supporters.
+class PropositionalRPG {
+public:
+	enum class Type {HFF, HMax, HAdd};
+
+	//! Returns the heuristic type with the given name, as given in the configuration ("hff", "hmax", "hadd")
+	static Type parse_type(const std::string& name);
+
+	//! Returns true iff the given problem is STRIPS-like, in the sense described above
+	static bool is_supported(const Problem& problem);
+
+	PropositionalRPG(const Problem& problem, Type type);
+	~PropositionalRPG() = default;
+
+	PropositionalRPG(const PropositionalRPG&) = delete;
+	PropositionalRPG(PropositionalRPG&&) = default;
+	PropositionalRPG& operator=(const PropositionalRPG&) = delete;
+	PropositionalRPG& operator=(PropositionalRPG&&) = default;
+
+	//! Returns the heuristic value of the given state, or -1 if the goal is unreachable from it
+	long evaluate(const State& seed);
+
+protected:
+	Type _type;
+
+	//! The tuple index of the atom 'X=1' of each state variable X
+	std::vector<TupleIdx> _variable_tuples;
+
+	//! The preconditions and add effects of action 'a' are in the ranges [_pre_offsets[a], _pre_offsets[a+1])
+	//! and [_add_offsets[a], _add_offsets[a+1]) of the corresponding arrays
+	std::vector<unsigned> _pre_offsets;
+	std::vector<TupleIdx> _preconditions;
+	std::vector<unsigned> _add_offsets;
+	std::vector<TupleIdx> _adds;
+
+	//! The actions that have tuple 't' as a precondition are in the range [_trigger_offsets[t], _trigger_offsets[t+1]) of '_triggers'
+	std::vector<unsigned> _trigger_offsets;
+	std::vector<ActionIdx> _triggers;
+
+	//! The actions without preconditions
+	std::vector<ActionIdx> _unconditioned;
+
+	std::vector<TupleIdx> _goal;
+	std::vector<bool> _is_goal;
+
+	//! Per-evaluation data, allocated once and reset on each evaluation
+	std::vector<long> _cost;
+	std::vector<ActionIdx> _supporter;
+	std::vector<unsigned> _unsatisfied;
+	std::vector<long> _action_cost;
+	std::vector<std::pair<long, TupleIdx>> _queue;
+	std::vector<bool> _in_plan;
+	std::vector<bool> _marked;
+	std::vector<TupleIdx> _open;
+
+	//! Appends to 'tuples' the tuples of the conjunction of positive atoms 'formula'. Returns false if the formula is not such a conjunction.
+	static bool collect_atoms(const fs::Formula* formula, const TupleIndex& tuple_index, std::vector<TupleIdx>& tuples);
+
+	//! Enqueues the add effects of the given action, whose preconditions have just been all reached
+	void apply(ActionIdx action);
+
+	//! Extracts a relaxed plan from the best supporters of the goal atoms, and returns its number of actions
+	long extract_plan();
+};
+
+} // namespaces
@@ -21,18 +21,18 @@ namespace fs0 {
 class SupportedAction {
 public:
 	const ActionID* _action;
-	Atom::vctrp _support;
+	Atom::vctr _support;
 	
-	SupportedAction(const ActionID* action, Atom::vctrp support) : 
-		_action(action), _support(support) {}
+	SupportedAction(const ActionID* action, Atom::vctr&& support) : 
+		_action(action), _support(std::move(support)) {}
 	
 	inline bool operator==(const SupportedAction& rhs) const { 
-		return _action == rhs._action && *_support == *(rhs._support);
+		return _action == rhs._action && _support == rhs._support;
 	}
 	
 	inline bool operator!=(const SupportedAction& rhs) const {return !this->operator==(rhs);}
 	inline bool operator< (const SupportedAction& rhs) const {
-		return _action < rhs._action || (_action == rhs._action && *_support < *(rhs._support));
+		return _action < rhs._action || (_action == rhs._action && _support < rhs._support);
 	}
 	inline bool operator> (const SupportedAction& rhs) const {return  rhs.operator<(*this);}
 	inline bool operator<=(const SupportedAction& rhs) const {return !this->operator>(rhs);}
@@ -42,7 +42,7 @@ public:
 	friend std::ostream& operator<<(std::ostream &os, const SupportedAction& o) { return o.print(os); }
 	std::ostream& print(std::ostream& out) const {
 		out << *_action << ", where: ";
-		for (const auto& atom:*(_support))  out << atom << ", ";
+		for (const auto& atom:_support)  out << atom << ", ";
 		return out;
 	}
 };
@@ -98,6 +98,7 @@ public:
 protected:
 	//! Put all the atoms in a given vector of atoms in the queue to be processed.
 	inline void enqueueAtoms(const Atom::vctr& atoms) { for(auto& atom:atoms) pending.push(atom); }
+	inline void enqueueAtoms(const Atom* first, const Atom* last) { for(; first != last; ++first) pending.push(*first); }
 
 	//! Process a single atom by seeking its supports left-to-right in the RPG and enqueuing them to be further processed
 	void processAtom(const Atom& atom) {
@@ -106,11 +107,9 @@ protected:
 		
 		const typename RPGBookkeeping::AtomSupport& support = _data.getAtomSupport(atom);
 		
-		const ActionID* action_id = std::get<1>(support);
-		_unused(action_id);
-		assert(action_id);
+		assert(support.action);
 		registerPlanAction(support);
-		enqueueAtoms(*(std::get<2>(support))); // Push the full support of the atom
+		enqueueAtoms(_data.support_begin(support), _data.support_end(support)); // Push the full support of the atom
 		processed.insert(atom); // Tag the atom as processed.
 	}
 	
@@ -146,7 +145,7 @@ protected:
 	
 	void registerPlanAction(const typename RPGBookkeeping::AtomSupport& support) {
 		// Push the action along the full support of the particular atom
-		supporters.insert(SupportedAction(std::get<1>(support), std::get<2>(support)));
+		supporters.insert(SupportedAction(support.action, Atom::vctr(this->_data.support_begin(support), this->_data.support_end(support))));
 	}
 	
 	long buildRelaxedPlan() {
@@ -178,7 +177,7 @@ protected:
 
 	void registerPlanAction(const typename RPGBookkeeping::AtomSupport& support) {
 		// We ignore the particular atom support and take only into account the action
-		perLayerSupporters[std::get<0>(support)].insert(std::get<1>(support));
+		perLayerSupporters[support.layer].insert(support.action);
 	}
 	
 	long buildRelaxedPlan() {
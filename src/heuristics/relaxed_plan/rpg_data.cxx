@@ -4,103 +4,144 @@
 #include <state.hxx>
 #include <actions/actions.hxx>
 #include <actions/action_id.hxx>
+#include <utils/tuple_index.hxx>
 #include <problem_info.hxx>
 
 namespace fs0 {
 
-RPGData::RPGData(const State& seed, bool ignore_negated) :
-	_novel(seed.numAtoms()),
+RPGData::RPGData(const TupleIndex& tuple_index, bool ignore_negated) :
+	_tuple_index(tuple_index),
+	_ignore_negated(ignore_negated),
+	_num_tuples(tuple_index.size()),
+	_predicative(),
+	_novel(),
 	_num_novel(0),
+	_novel_variables(),
 	_current_layer(0),
-	_effects()
+	_supports(),
+	_touched(),
+	_arena(),
+	_pending(0),
+	_action_ids(),
+	_num_action_ids(0)
 {
 	const ProblemInfo& info = ProblemInfo::getInstance();
-	
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		_predicative.push_back(info.isPredicativeVariable(variable));
+	}
+	_novel.resize(_predicative.size());
+	_supports.resize(_num_tuples + _predicative.size(), AtomSupport{UNREACHED, nullptr, 0, 0});
+}
+
+void RPGData::reset(const State& seed) {
+	for (unsigned position:_touched) {
+		_supports[position] = AtomSupport{UNREACHED, nullptr, 0, 0};
+	}
+	_touched.clear();
+	_arena.clear();
+	_pending = 0;
+	_num_action_ids = 0;
+
+	for (VariableIdx variable:_novel_variables) _novel[variable].clear();
+	_novel_variables.clear();
+	_num_novel = 0;
+	_current_layer = 0;
+
 	// Initially we insert the seed state atoms
 	for (unsigned variable = 0; variable < seed.numAtoms(); ++variable) {
 		ObjectIdx value = seed.getValue(variable);
-		
-		if (ignore_negated && info.isPredicativeVariable(variable) && value == 0) { // TODO This check is expensive and should be optimized out
+
+		if (_ignore_negated && _predicative[variable] && value == 0) {
 			continue; // If requested, we ignore negated predicative atoms.
 		}
-		
-		_effects.insert(std::make_pair(Atom(variable, value),
-						createAtomSupport(nullptr, std::make_shared<std::vector<Atom>>())));
+
+		unsigned hint = position(Atom(variable, value));
+		_supports[hint] = AtomSupport{_current_layer, nullptr, _pending, _pending};
+		_touched.push_back(hint);
 	}
 	LPT_EDEBUG("heuristic", "RPG Layer #" << getCurrentLayerIdx() << ": " << *this);
 	advanceLayer();
 }
 
-RPGData::~RPGData() {
-	// delete all the pointers to action IDs, which belong to this container
-	for (auto& effect:_effects) {
-		const ActionID* action_id = std::get<1>(effect.second);
-		delete action_id;
-	}
-}
-
 void RPGData::advanceLayer() {
+	// Clear the novel atoms, but keep the allocated memory
+	for (VariableIdx variable:_novel_variables) _novel[variable].clear();
+	_novel_variables.clear();
 	_num_novel= 0;
-	_novel = std::vector<std::vector<ObjectIdx>>(_novel.size()); // completely clear the vector of novel atoms
 	++_current_layer;
 }
 
-RPGData::AtomSupport RPGData::createAtomSupport(const ActionID* action, Atom::vctrp support) const {
-	return std::make_tuple(_current_layer, action, support);
+unsigned RPGData::position(const Atom& atom) const {
+	VariableIdx variable = atom.getVariable();
+	if (_predicative[variable] && atom.getValue() == 0) return _num_tuples + variable;
+	return _tuple_index.to_index(variable, atom.getValue());
 }
 
 const RPGData::AtomSupport& RPGData::getAtomSupport(const Atom& atom) const {
-	auto it = _effects.find(atom);
-	assert(it != _effects.end());
-	return it->second;
+	const AtomSupport& support = _supports[position(atom)];
+	assert(support.layer != UNREACHED);
+	return support;
+}
+
+std::pair<bool, unsigned> RPGData::getInsertionHint(const Atom& atom) const {
+	unsigned hint = position(atom);
+	return std::make_pair(_supports[hint].layer == UNREACHED, hint);
 }
 
-std::pair<bool, RPGData::SupportMap::iterator> RPGData::getInsertionHint(const Atom& atom) {
-	SupportMap::iterator lb = _effects.lower_bound(atom); // @see http://stackoverflow.com/a/101980
-	bool keyInMap = lb != _effects.end() && !(_effects.key_comp()(atom, lb->first));
-	if (keyInMap) return std::make_pair(false, lb);
-	else return std::make_pair(true, lb);
+const ActionID* RPGData::action_id(const GroundAction* action) {
+	// Reuse the IDs of previous evaluations before growing the arena
+	if (_num_action_ids < _action_ids.size()) _action_ids[_num_action_ids] = PlainActionID(action);
+	else _action_ids.emplace_back(action);
+	return &_action_ids[_num_action_ids++];
 }
 
-void RPGData::add(const Atom& atom, const ActionID* action, Atom::vctrp support, SupportMap::iterator hint) {
-	_effects.insert(hint, std::make_pair(atom, createAtomSupport(action, support)));
-	_novel[atom.getVariable()].push_back(atom.getValue());
+void RPGData::add(const Atom& atom, const ActionID* action, unsigned hint) {
+	assert(_supports[hint].layer == UNREACHED);
+	_supports[hint] = AtomSupport{_current_layer, action, _pending, (unsigned) _arena.size()};
+	_pending = _arena.size();
+	_touched.push_back(hint);
+
+	std::vector<ObjectIdx>& novel = _novel[atom.getVariable()];
+	if (novel.empty()) _novel_variables.push_back(atom.getVariable());
+	novel.push_back(atom.getValue());
 	++_num_novel;
 }
 
-void RPGData::add(const Atom& atom, const ActionID* action, Atom::vctrp support) {
+void RPGData::add(const Atom& atom, const ActionID* action) {
 	auto hint = getInsertionHint(atom);
-	if (!hint.first) return; // Don't insert the atom if it was already tracked by the RPG
-	add(atom, action, support, hint.second);
+	if (!hint.first) { // Don't insert the atom if it was already tracked by the RPG
+		_arena.erase(_arena.begin() + _pending, _arena.end()); // Discard the support atoms that might have been pushed
+		return;
+	}
+	add(atom, action, hint.second);
 }
 
 unsigned RPGData::compute_hmax_sum(const std::vector<Atom>& atoms) const {
 	unsigned sum = 0;
 	for (const Atom& atom:atoms) {
-		sum += std::get<0>(getAtomSupport(atom));
+		sum += getAtomSupport(atom).layer;
 	}
 	return sum;
 }
 
 std::ostream& RPGData::print(std::ostream& os) const {
-	os << "Relaxed Planning Graph atoms (" << _effects.size() << "): " << std::endl;
-	for (const auto& x:_effects) {
-		const ActionID* action_id = std::get<1>(x.second);
-		os << x.first  << " - action: ";
-		(action_id ? os << *action_id : os << "[INVALID-ACTION]");
-		os << " - layer #" << std::get<0>(x.second) << " - support: ";
-		printAtoms(std::get<2>(x.second), os);
+	os << "Relaxed Planning Graph atoms (" << _touched.size() << "): " << std::endl;
+	for (unsigned position:_touched) {
+		const AtomSupport& support = _supports[position];
+		os << (position < _num_tuples ? _tuple_index.to_atom(position) : Atom(position - _num_tuples, 0))  << " - action: ";
+		(support.action ? os << *support.action : os << "[INVALID-ACTION]");
+		os << " - layer #" << support.layer << " - support: ";
+		printAtoms(support, os);
 		os << std::endl;
 	}
 	os << std::endl;
 	return os;
 }
 
-void RPGData::printAtoms(const Atom::vctrp vector, std::ostream& os) const {
-	for (const auto& fact:*vector) {
-		os << fact << ", ";
+void RPGData::printAtoms(const AtomSupport& support, std::ostream& os) const {
+	for (const Atom* fact = support_begin(support); fact != support_end(support); ++fact) {
+		os << *fact << ", ";
 	}
 }
 
 } // namespaces
-
@@ -1,15 +1,17 @@
 
 #pragma once
 
-#include <map>
+#include <deque>
+#include <limits>
 #include <fs_types.hxx>
 #include <atom.hxx>
+#include <actions/action_id.hxx>
 
 
 namespace fs0 {
 
 class State;
-class ActionID;
+class TupleIndex;
 
 /**
  * A data structure containing book-keeping information concerning the actions that support
@@ -17,65 +19,123 @@ class ActionID;
  * the atoms that make an action applicable (in a certain RPG layer) and the "extra"
  * atoms that make a particular effect reachable, i.e. those related to the relevant
  * variables of the effect procedure that achieves the effect.
+ *
+ * The object is meant to be reused across heuristic evaluations: supports are stored in a flat array indexed
+ * by the tuple index of each atom, and the support atoms and action IDs of all of them in arenas, so that no
+ * allocation is needed once the buffers have grown enough, and clearing the data takes time linear in the
+ * number of atoms reached in the previous evaluation.
  */
 class RPGData {
 public:
-	//! <layer ID, Action ID, support>
-	typedef std::tuple<unsigned, const ActionID*, Atom::vctrp> AtomSupport;
-	typedef std::map<Atom, AtomSupport> SupportMap;
+	//! <layer ID, Action ID, support>, where the support is the range [first, last) of atoms of the arena
+	struct AtomSupport {
+		unsigned layer;
+		const ActionID* action;
+		unsigned first;
+		unsigned last;
+	};
+
+	//! The layer of atoms that have not been reached
+	static const unsigned UNREACHED = std::numeric_limits<unsigned>::max();
 
 protected:
+	const TupleIndex& _tuple_index;
+
+	//! Whether negated predicative atoms must be ignored when inserting the atoms of the seed state
+	bool _ignore_negated;
+
+	//! The number of tuples of the tuple index
+	unsigned _num_tuples;
+
+	//! Whether each state variable is predicative
+	std::vector<bool> _predicative;
+
 	//! This keeps a reference to the novel atoms that have been inserted in the most recent layer of the RPG.
 	std::vector<std::vector<ObjectIdx>> _novel;
 	unsigned _num_novel;
 
+	//! The variables with some novel atom in the most recent layer
+	std::vector<VariableIdx> _novel_variables;
+
 	//! The current number of layers.
 	unsigned _current_layer;
 
 	/**
-	 * A map mapping every atom X=x reached in the RPG layer represented by this changeset to a pair < L, A, V >, where:
-	 * - 'L' is the first layer at which the atom has been achieved.
+	 * The support < L, A, V > of every atom X=x, where:
+	 * - 'L' is the first layer at which the atom has been achieved, or UNREACHED.
 	 * - 'A' is the index of one of the actions that achieves the atom.
-	 * - 'V' is a vector with all the atoms that support the achievement of atom X=x through the application of action A.
+	 * - 'V' is the range of the arena with all the atoms that support the achievement of atom X=x through the application of action A.
+	 * The support of X=x is at the position given by the tuple index of the atom, except for negated predicative atoms X=0,
+	 * which have no tuple and are at position 'N + X', where N is the number of tuples.
 	 */
-	SupportMap _effects;
+	std::vector<AtomSupport> _supports;
+
+	//! The positions of '_supports' of all the atoms reached so far
+	std::vector<unsigned> _touched;
+
+	//! The atoms of all supports
+	std::vector<Atom> _arena;
+
+	//! The position of the arena where the support of the next atom to be added starts
+	unsigned _pending;
+
+	//! The action IDs of all supports. A deque, so that growing it does not invalidate the IDs handed out before.
+	std::deque<PlainActionID> _action_ids;
+
+	//! The number of action IDs of '_action_ids' in use since the last reset
+	unsigned _num_action_ids;
 
 public:
-	RPGData(const State& seed, bool ignore_negated = false);
-	~RPGData();
+	RPGData(const TupleIndex& tuple_index, bool ignore_negated = false);
+
+	RPGData(const RPGData&) = delete;
+	RPGData(RPGData&&) = default;
+	RPGData& operator=(const RPGData&) = delete;
+	RPGData& operator=(RPGData&&) = delete;
+
+	//! Clears the data of the previous RPG (if any) and starts a new one from the given seed state
+	void reset(const State& seed);
 
 	//! Returns the number of layers of the RPG.
 	unsigned getNumLayers() const  {return _current_layer + 1; } // 0-indexed!
-	
+
 	//! Returns the current layer index
 	unsigned getCurrentLayerIdx() const  {return _current_layer; }
 
 	//! Closes the last RPG layer and opens up a new one
 	void advanceLayer();
-	
-	//! Creates an atom support data structure with the given data and taking into account the current RPG layer
-	AtomSupport createAtomSupport(const ActionID* action, Atom::vctrp support) const;
 
 	//! Returns the support for the given atom
 	const AtomSupport& getAtomSupport(const Atom& atom) const;
 
+	//! Returns the range of atoms of the given support
+	const Atom* support_begin(const AtomSupport& support) const { return _arena.data() + support.first; }
+	const Atom* support_end(const AtomSupport& support) const { return _arena.data() + support.last; }
+
 	//! Get the number of novel atoms in the last layer of the RPG
 	unsigned getNumNovelAtoms() const { return _num_novel; }
-	
+
 	const std::vector<std::vector<ObjectIdx>>& getNovelAtoms() const { return _novel; }
 
 
-	//! Returns a pair "<b, it>" such that b is true iff the given atom is not already tracked by the RPG.
-	//! In that case, 'it' is an iterator that can be used as an insertion hint
-	//! If, on the other hand, b is false, 'it' is a valid iterator pointing to the atom support
-	std::pair<bool, SupportMap::iterator> getInsertionHint(const Atom& atom);
-	
+	//! Returns a pair "<b, hint>" such that b is true iff the given atom is not already tracked by the RPG,
+	//! and 'hint' is the position of the atom support, which can be used as an insertion hint
+	std::pair<bool, unsigned> getInsertionHint(const Atom& atom) const;
+
+	//! Appends the given atom to the support of the next atom to be added
+	void push_support(const Atom& atom) { _arena.push_back(atom); }
+
+	//! Returns an ID of the given action, which remains valid until the next reset
+	const ActionID* action_id(const GroundAction* action);
+
 	//! The version with hint assumes that the atom needs to be inserted.
-	void add(const Atom& atom, const ActionID* action, Atom::vctrp support, SupportMap::iterator hint);
-	
+	//! The support of the atom is made up of all atoms pushed since the last insertion.
+	//! The RPG does not take ownership of the action ID, which is expected to come from 'action_id'.
+	void add(const Atom& atom, const ActionID* action, unsigned hint);
+
 	//! Add an atom to the set of newly-reached atoms, only if it is indeed new.
-	void add(const Atom& atom, const ActionID* action, Atom::vctrp support);
-	
+	void add(const Atom& atom, const ActionID* action);
+
 	//! Compute the sum of h_max values of all the given atoms, assuming that they have already been reached in the RPG data structure
 	unsigned compute_hmax_sum(const std::vector<Atom>& atoms) const;
 
@@ -84,7 +144,11 @@ public:
 	//! Prints a representation of the RPG data to the given stream.
 	std::ostream& print(std::ostream& os) const;
 
-	void printAtoms(const Atom::vctrp vector, std::ostream& os) const;
+	void printAtoms(const AtomSupport& support, std::ostream& os) const;
+
+protected:
+	//! The position of the support of the given atom
+	unsigned position(const Atom& atom) const;
 };
 
 
@@ -16,6 +16,10 @@ RPGIndex::RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHa
 	_novel_tuples(),
 	_current_layer(0),
 	_extension_handler(extension_handler),
+	_modified_variables(),
+	_is_modified(seed.numAtoms(), false),
+	_variable_change_layer(seed.numAtoms(), 0),
+	_symbol_change_layer(ProblemInfo::getInstance().getNumLogicalSymbols(), 0),
 	_tuple_index(tuple_index),
 	_seed(seed)
 {
@@ -37,6 +41,12 @@ RPGIndex::RPGIndex(const State& seed, const TupleIndex& tuple_index, ExtensionHa
 			_domains.push_back(Gecode::IntSet()); // We simply push an empty domain for those predicative state variables that are set to false.
 		}
 	}
+	// The domains of the seed have already been built
+	for (VariableIdx variable:_modified_variables) {
+		_is_modified[variable] = false;
+		_variable_change_layer[variable] = _current_layer + 1;
+	}
+	_modified_variables.clear();
 	next();
 }
 
@@ -47,20 +57,25 @@ void RPGIndex::advance() {
 		_extension_handler.process_tuple(tuple);
 	}
 	
-	// Now update the per-variable domains
-	for (unsigned variable = 0; variable < _domains_raw.size(); ++variable) {
+	// Now update the domains of those variables that got some new value; the rest remain as in the previous layer
+	for (VariableIdx variable:_modified_variables) {
 		const auto& all = _domains_raw[variable];
 		// An intermediate IntArgs object seems to be necessary, since IntSets do not accept std-like range constructors.
 		_domains[variable] = Gecode::IntSet(Gecode::IntArgs(all.cbegin(), all.cend()));
+		_is_modified[variable] = false;
+		_variable_change_layer[variable] = _current_layer + 1;
 	}
+	_modified_variables.clear();
 	
 	next();
 }
 
 void RPGIndex::next() {
-	_extensions = _extension_handler.generate_extensions();
+	// Only the extensions of the symbols that changed in the last layer are regenerated
+	_extension_handler.update_extensions(_extensions);
 	_novel_tuples.clear();
 	++_current_layer;
+	for (unsigned symbol:_extension_handler.get_modified_symbols()) _symbol_change_layer[symbol] = _current_layer;
 }
 
 
@@ -90,15 +105,25 @@ bool RPGIndex::reached(TupleIdx tuple) const {
 	return _reached.at(tuple) != nullptr;
 }
 
+bool RPGIndex::reached_before_current_layer(TupleIdx tuple) const {
+	const TupleSupport* support = _reached.at(tuple);
+	return support != nullptr && std::get<0>(*support) < _current_layer;
+}
+
 void RPGIndex::add(TupleIdx tuple, const ActionID* action, std::vector<TupleIdx>&& support) {
 	auto& it = _reached.at(tuple);
 	if (it != nullptr) return; // Don't insert the atom if it was already tracked by the RPG
 	it = createTupleSupport(action, std::move(support)); // This effectively inserts the tuple into '_reached'
 	_novel_tuples.push_back(tuple);
 	const Atom& atom = _tuple_index.to_atom(tuple);
-	auto& domain = _domains_raw.at(atom.getVariable());
+	VariableIdx variable = atom.getVariable();
+	auto& domain = _domains_raw.at(variable);
 	// assert(std::find(domain.cbegin(), domain.cend(), atom.getValue()) == domain.end()); // Warning: this is expensive
 	domain.push_back(atom.getValue());
+	if (!_is_modified[variable]) {
+		_is_modified[variable] = true;
+		_modified_variables.push_back(variable);
+	}
 }
 
 /*
@@ -56,6 +56,16 @@ protected:
 	//! This is the set of all values reached so far for each state variable
 	std::vector<std::vector<ObjectIdx>> _domains_raw;
 	
+	//! The state variables that got some new value in the current layer, whose domains need to be rebuilt on the next one
+	std::vector<VariableIdx> _modified_variables;
+	
+	//! _is_modified[v] is true iff variable 'v' is in '_modified_variables'
+	std::vector<bool> _is_modified;
+	
+	//! The last layer in which the domain of each state variable / the extension of each logical symbol changed
+	std::vector<unsigned> _variable_change_layer;
+	std::vector<unsigned> _symbol_change_layer;
+	
 	const TupleIndex& _tuple_index;
 	
 	const State& _seed;
@@ -67,6 +77,10 @@ public:
 	//! Returns true if the given tuple has already been reached in the current graph.
 	bool reached(TupleIdx tuple) const;
 	
+	//! Returns true if the given tuple was reached in some layer before the current one, i.e. if it belongs to the
+	//! layer being currently expanded, as opposed to having been reached while expanding it.
+	bool reached_before_current_layer(TupleIdx tuple) const;
+	
 	bool is_true(VariableIdx variable) const;
 	const Gecode::TupleSet& get_extension(unsigned symbol_id) const { return _extensions.at(symbol_id); }
 	const std::vector<Gecode::IntSet>& get_domains() const { return _domains; }
@@ -77,6 +91,14 @@ public:
 	
 	//! Returns the current layer index
 	unsigned getCurrentLayerIdx() const  {return _current_layer; }
+	
+	//! Whether the current layer is the first one, i.e. the one built from the seed state
+	bool is_first_layer() const { return _current_layer == 1; }
+	
+	//! Whether the domain of the given state variable / the extension of the given symbol changed in the current layer
+	//! with respect to the previous one
+	bool changed_in_current_layer(VariableIdx variable) const { return _variable_change_layer[variable] == _current_layer; }
+	bool symbol_changed_in_current_layer(unsigned symbol) const { return _symbol_change_layer[symbol] == _current_layer; }
 
 	//! Returns the support for the given atom
 	const TupleSupport& getTupleSupport(TupleIdx tuple) const;
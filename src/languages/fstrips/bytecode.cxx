@@ -0,0 +1,197 @@
+
+#include <languages/fstrips/bytecode.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <problem_info.hxx>
+#include <utils/static.hxx>
+#include <state.hxx>
+
+namespace fs0 { namespace language { namespace fstrips {
+
+//! The recursive lowering of formulae and terms, which keeps track of the depth of the stack at each point of the program
+class Bytecode::Compiler {
+public:
+	Compiler() : _code(), _depth(0), _max_depth(0) {}
+
+	bool formula(const Formula* formula) {
+		if (formula->is_tautology()) return true;
+		if (formula->is_contradiction()) return emit(Op::FAIL, 0);
+
+		if (auto conjunction = dynamic_cast<const Conjunction*>(formula)) {
+			for (const AtomicFormula* conjunct:conjunction->getConjuncts()) {
+				if (!this->formula(conjunct)) return false;
+			}
+			return true;
+		}
+
+		auto relational = dynamic_cast<const RelationalFormula*>(formula);
+		if (!relational) return false; // Quantified formulae, fluent atoms and externally-defined formulae are not compiled
+
+		RelationalFormula::Symbol symbol = relational->symbol();
+		auto variable = dynamic_cast<const StateVariable*>(relational->lhs());
+		auto constant = dynamic_cast<const Constant*>(relational->rhs());
+		if (variable && constant && (symbol == RelationalFormula::Symbol::EQ || symbol == RelationalFormula::Symbol::NEQ)) {
+			Op op = (symbol == RelationalFormula::Symbol::EQ) ? Op::VAR_EQ : Op::VAR_NEQ;
+			_code.push_back(Instruction{op, 0, (int) variable->getValue(), constant->getValue(), nullptr});
+			return true;
+		}
+
+		if (!term(relational->lhs()) || !term(relational->rhs())) return false;
+		switch (symbol) {
+			case RelationalFormula::Symbol::EQ: return emit(Op::EQ, -2);
+			case RelationalFormula::Symbol::NEQ: return emit(Op::NEQ, -2);
+			case RelationalFormula::Symbol::LT: return emit(Op::LT, -2);
+			case RelationalFormula::Symbol::LEQ: return emit(Op::LEQ, -2);
+			case RelationalFormula::Symbol::GT: return emit(Op::GT, -2);
+			case RelationalFormula::Symbol::GEQ: return emit(Op::GEQ, -2);
+		}
+		return false;
+	}
+
+	bool term(const Term* term) {
+		if (auto variable = dynamic_cast<const StateVariable*>(term)) {
+			return emit(Op::LOAD, 1, variable->getValue());
+		}
+
+		if (auto constant = dynamic_cast<const Constant*>(term)) {
+			return emit(Op::CONST, 1, constant->getValue());
+		}
+
+		if (auto arithmetic = dynamic_cast<const ArithmeticTerm*>(term)) {
+			if (!subterms(arithmetic->getSubterms())) return false;
+			if (dynamic_cast<const AdditionTerm*>(term)) return emit(Op::ADD, -1);
+			if (dynamic_cast<const SubtractionTerm*>(term)) return emit(Op::SUB, -1);
+			if (dynamic_cast<const MultiplicationTerm*>(term)) return emit(Op::MUL, -1);
+			return false;
+		}
+
+		if (auto nested = dynamic_cast<const UserDefinedStaticTerm*>(term)) {
+			const DenseExtension* table = ProblemInfo::getInstance().getSymbolData(nested->getSymbolId()).getDenseExtension();
+			unsigned arity = nested->getSubterms().size();
+			if (!table || table->arity() != arity) return false; // Only static symbols with a dense extension are compiled
+			if (!subterms(nested->getSubterms())) return false;
+			_code.push_back(Instruction{Op::STATIC, arity, 0, 0, table});
+			return move(1 - (int) arity);
+		}
+
+		if (auto nested = dynamic_cast<const FluentHeadedNestedTerm*>(term)) {
+			unsigned arity = nested->getSubterms().size();
+			if (!subterms(nested->getSubterms())) return false;
+			_code.push_back(Instruction{Op::FLUENT, arity, (int) nested->getSymbolId(), 0, nullptr});
+			return move(1 - (int) arity);
+		}
+
+		return false; // Bound variables cannot be compiled
+	}
+
+	bool variable(const Term* term) {
+		if (auto variable = dynamic_cast<const StateVariable*>(term)) {
+			return emit(Op::CONST, 1, variable->getValue());
+		}
+
+		if (auto nested = dynamic_cast<const FluentHeadedNestedTerm*>(term)) {
+			unsigned arity = nested->getSubterms().size();
+			if (!subterms(nested->getSubterms())) return false;
+			_code.push_back(Instruction{Op::RESOLVE, arity, (int) nested->getSymbolId(), 0, nullptr});
+			return move(1 - (int) arity);
+		}
+
+		return false;
+	}
+
+	Bytecode program() {
+		Bytecode bytecode;
+		bytecode._valid = true;
+		bytecode._code = std::move(_code);
+		return bytecode;
+	}
+
+protected:
+	std::vector<Instruction> _code;
+
+	//! The current and the maximum depth of the stack
+	int _depth;
+	int _max_depth;
+
+	bool subterms(const std::vector<const Term*>& subterms) {
+		for (const Term* subterm:subterms) {
+			if (!term(subterm)) return false;
+		}
+		return true;
+	}
+
+	bool emit(Op op, int delta, int a = 0) {
+		_code.push_back(Instruction{op, 0, a, 0, nullptr});
+		return move(delta);
+	}
+
+	//! Updates the depth of the stack, failing if the program would need a larger stack than available
+	bool move(int delta) {
+		_depth += delta;
+		assert(_depth >= 0);
+		_max_depth = std::max(_max_depth, _depth);
+		return _max_depth <= (int) MAX_STACK;
+	}
+};
+
+
+Bytecode Bytecode::compile_formula(const Formula* formula) {
+	Compiler compiler;
+	return compiler.formula(formula) ? compiler.program() : Bytecode();
+}
+
+Bytecode Bytecode::compile_term(const Term* term) {
+	Compiler compiler;
+	return compiler.term(term) ? compiler.program() : Bytecode();
+}
+
+Bytecode Bytecode::compile_variable(const Term* term) {
+	Compiler compiler;
+	return compiler.variable(term) ? compiler.program() : Bytecode();
+}
+
+bool Bytecode::run(const State& state, ObjectIdx* stack) const {
+	assert(_valid);
+	unsigned top = 0; // The first free position of the stack
+	for (const Instruction& instruction:_code) {
+		switch (instruction.op) {
+			case Op::CONST: stack[top++] = instruction.a; break;
+			case Op::LOAD: stack[top++] = state.getValue(instruction.a); break;
+			case Op::ADD: --top; stack[top - 1] = stack[top - 1] + stack[top]; break;
+			case Op::SUB: --top; stack[top - 1] = stack[top - 1] - stack[top]; break;
+			case Op::MUL: --top; stack[top - 1] = stack[top - 1] * stack[top]; break;
+			case Op::STATIC:
+				top -= instruction.arity;
+				stack[top] = instruction.table->value(stack + top);
+				++top;
+				break;
+			case Op::FLUENT:
+				top -= instruction.arity;
+				stack[top] = state.getValue(ProblemInfo::getInstance().resolveStateVariable(instruction.a, stack + top, instruction.arity));
+				++top;
+				break;
+			case Op::RESOLVE:
+				top -= instruction.arity;
+				stack[top] = ProblemInfo::getInstance().resolveStateVariable(instruction.a, stack + top, instruction.arity);
+				++top;
+				break;
+			case Op::EQ: top -= 2; if (!(stack[top] == stack[top + 1])) return false; break;
+			case Op::NEQ: top -= 2; if (!(stack[top] != stack[top + 1])) return false; break;
+			case Op::LT: top -= 2; if (!(stack[top] < stack[top + 1])) return false; break;
+			case Op::LEQ: top -= 2; if (!(stack[top] <= stack[top + 1])) return false; break;
+			case Op::GT: top -= 2; if (!(stack[top] > stack[top + 1])) return false; break;
+			case Op::GEQ: top -= 2; if (!(stack[top] >= stack[top + 1])) return false; break;
+			case Op::VAR_EQ: if (state.getValue(instruction.a) != instruction.b) return false; break;
+			case Op::VAR_NEQ: if (state.getValue(instruction.a) == instruction.b) return false; break;
+			case Op::FAIL: return false;
+		}
+	}
+	return true;
+}
+
+
+bool CompiledFormula::interpret(const State& state) const {
+	return _code.valid() ? _code.holds(state) : _formula->interpret(state);
+}
+
+} } } // namespaces
@@ -0,0 +1,110 @@
+
+#pragma once
+
+#include <vector>
+
+#include <fs_types.hxx>
+
+namespace fs0 { class State; class DenseExtension; }
+
+namespace fs0 { namespace language { namespace fstrips {
+
+class Term;
+class Formula;
+
+//! A ground formula or term lowered into a flat sequence of instructions for a small stack machine, so that it can
+//! be evaluated on a state with a single loop, without virtual calls nor heap allocations.
+//! - Terms push their value on the stack: constants and state variables directly, and nested terms after their subterms.
+//!   Static symbols are evaluated through their dense extension, and fluent-headed nested terms through the resolution
+//!   of the state variable they denote.
+//! - Atomic formulae pop their two operands and abort the evaluation when they do not hold; a conjunction is simply
+//!   the concatenation of the programs of its conjuncts. Comparisons between a state variable and a constant,
+//!   by far the most common atoms, are fused into a single instruction.
+//! Only ground, quantifier-free formulae made up of the builtin relational and arithmetic symbols and of static symbols
+//! with a dense extension are compiled; for any other formula or term, the compilation returns an invalid program
+//! and the caller is expected to fall back to the interpretation of the original formula or term.
+class Bytecode {
+public:
+	enum class Op : unsigned char {
+		CONST,     // Push 'a'
+		LOAD,      // Push the value of variable 'a'
+		ADD, SUB, MUL,
+		STATIC,    // Pop 'arity' arguments and push the value of the static symbol with dense extension 'table'
+		FLUENT,    // Pop 'arity' arguments and push the value of the state variable of symbol 'a' they denote
+		RESOLVE,   // Pop 'arity' arguments and push the index of the state variable of symbol 'a' they denote
+		EQ, NEQ, LT, LEQ, GT, GEQ, // Pop two operands and fail if the relation does not hold
+		VAR_EQ,    // Fail unless the value of variable 'a' equals 'b'
+		VAR_NEQ,   // Fail if the value of variable 'a' equals 'b'
+		FAIL
+	};
+
+	struct Instruction {
+		Op op;
+		unsigned arity;
+		int a;
+		int b;
+		const DenseExtension* table;
+	};
+
+	//! The maximum stack depth of a compiled program
+	static const unsigned MAX_STACK = 32;
+
+	//! Compile the given formula, which needs to hold for the program to succeed
+	static Bytecode compile_formula(const Formula* formula);
+
+	//! Compile the given term, whose value is returned by the program
+	static Bytecode compile_term(const Term* term);
+
+	//! Compile the given state variable or fluent-headed nested term, whose state variable index is returned by the program
+	static Bytecode compile_variable(const Term* term);
+
+	//! An invalid program
+	Bytecode() : _valid(false), _code() {}
+
+	//! Whether the compilation was successful
+	bool valid() const { return _valid; }
+
+	//! Returns true iff the compiled formula holds in the given state
+	bool holds(const State& state) const {
+		ObjectIdx stack[MAX_STACK];
+		return run(state, stack);
+	}
+
+	//! Returns the value of the compiled term (or variable) in the given state
+	ObjectIdx evaluate(const State& state) const {
+		ObjectIdx stack[MAX_STACK];
+		run(state, stack);
+		return stack[0];
+	}
+
+	const std::vector<Instruction>& code() const { return _code; }
+
+protected:
+	bool _valid;
+
+	std::vector<Instruction> _code;
+
+	//! Runs the program with the given stack, returning false as soon as some atom fails
+	bool run(const State& state, ObjectIdx* stack) const;
+
+	class Compiler;
+};
+
+//! A (non-owning) reference to a ground formula plus its compiled program, if the formula could be compiled.
+//! Interpreting the formula uses the program whenever possible, and the formula tree otherwise.
+class CompiledFormula {
+public:
+	CompiledFormula(const Formula* formula) : _formula(formula), _code(Bytecode::compile_formula(formula)) {}
+
+	bool interpret(const State& state) const;
+
+	const Formula* formula() const { return _formula; }
+	const Bytecode& code() const { return _code; }
+
+protected:
+	const Formula* _formula;
+
+	Bytecode _code;
+};
+
+} } } // namespaces
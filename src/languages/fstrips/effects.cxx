@@ -12,6 +12,7 @@ namespace fs0 { namespace language { namespace fstrips {
 ActionEffect::ActionEffect(const Term* lhs, const Term* rhs, const Formula* condition)
 	: _lhs(lhs), _rhs(rhs), _condition(condition) {
 	if (!isWellFormed()) throw std::runtime_error("Ill-formed effect");
+	compile();
 }
 
 ActionEffect::~ActionEffect() {
@@ -22,7 +23,15 @@ ActionEffect::~ActionEffect() {
 
 ActionEffect::ActionEffect(const ActionEffect& other) :
 	_lhs(other._lhs->clone()), _rhs(other._rhs->clone()), _condition(other._condition->clone())
-{}
+{
+	compile();
+}
+
+void ActionEffect::compile() {
+	_lhs_code = Bytecode::compile_variable(_lhs);
+	_rhs_code = Bytecode::compile_term(_rhs);
+	_condition_code = Bytecode::compile_formula(_condition);
+}
 
 std::vector<const Term*> ActionEffect::all_terms() const {
 	std::vector<const Term*> res = _lhs->all_terms();
@@ -38,11 +47,13 @@ bool ActionEffect::isWellFormed() const {
 }
 
 Atom ActionEffect::apply(const State& state) const {
-	return Atom(_lhs->interpretVariable(state), _rhs->interpret(state));
+	VariableIdx variable = _lhs_code.valid() ? _lhs_code.evaluate(state) : _lhs->interpretVariable(state);
+	ObjectIdx value = _rhs_code.valid() ? _rhs_code.evaluate(state) : _rhs->interpret(state);
+	return Atom(variable, value);
 }
 
 bool ActionEffect::applicable(const State& state) const {
-	return _condition->interpret(state);
+	return _condition_code.valid() ? _condition_code.holds(state) : _condition->interpret(state);
 }
 
 std::ostream& ActionEffect::print(std::ostream& os) const { return print(os, ProblemInfo::getInstance()); }
@@ -3,6 +3,7 @@
 
 #include <fs_types.hxx>
 #include <atom.hxx>
+#include <languages/fstrips/bytecode.hxx>
 
 namespace fs0 {
 class ProblemInfo;
@@ -71,6 +72,13 @@ protected:
 	
 	//! The effect condition
 	const Formula* _condition;
+	
+	//! The compiled programs of the LHS variable, the RHS and the condition, valid only if the effect is ground
+	Bytecode _lhs_code;
+	Bytecode _rhs_code;
+	Bytecode _condition_code;
+	
+	void compile();
 };
 
 } } } // namespaces
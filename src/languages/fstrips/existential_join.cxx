@@ -0,0 +1,263 @@
+
+#include <languages/fstrips/existential_join.hxx>
+#include <languages/fstrips/language.hxx>
+#include <problem_info.hxx>
+#include <utils/static.hxx>
+#include <utils/binding.hxx>
+#include <state.hxx>
+
+namespace fs0 { namespace language { namespace fstrips {
+
+//! Returns the binding slots of all the quantified variables in the given atom
+static std::vector<unsigned> atom_variables(const AtomicFormula* atom) {
+	std::vector<unsigned> variables;
+	for (const Term* term:atom->all_terms()) {
+		if (auto variable = dynamic_cast<const BoundVariable*>(term)) variables.push_back(variable->getVariableId());
+	}
+	return variables;
+}
+
+ExistentialJoin* ExistentialJoin::create(const ExistentiallyQuantifiedFormula& formula) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<ExistentialJoin> join(new ExistentialJoin);
+	join->_subformula = std::unique_ptr<const Conjunction>(formula.getSubformula()->clone());
+
+	std::vector<bool> quantified;
+	join->_binding_size = 0;
+	for (const BoundVariable* variable:formula.getVariables()) {
+		join->_binding_size = std::max(join->_binding_size, variable->getVariableId() + 1);
+	}
+	quantified.resize(join->_binding_size, false);
+	join->_domains.resize(join->_binding_size);
+	for (const BoundVariable* variable:formula.getVariables()) {
+		quantified[variable->getVariableId()] = true;
+		auto& domain = join->_domains[variable->getVariableId()];
+		domain = info.getTypeObjects(variable->getType());
+		std::sort(domain.begin(), domain.end());
+	}
+
+	// Classify the atoms into relations and filters
+	const auto& conjuncts = join->_subformula->getConjuncts();
+	std::vector<const AtomicFormula*> filters;
+	for (const AtomicFormula* atom:conjuncts) {
+		std::vector<unsigned> variables = atom_variables(atom);
+		for (unsigned variable:variables) {
+			if (variable >= quantified.size() || !quantified[variable]) return nullptr; // The formula is not closed
+		}
+
+		auto eq = dynamic_cast<const EQAtomicFormula*>(atom);
+		auto nested = eq ? dynamic_cast<const NestedTerm*>(eq->lhs()) : nullptr;
+		auto constant = eq ? dynamic_cast<const Constant*>(eq->rhs()) : nullptr;
+		bool fluent = dynamic_cast<const FluentHeadedNestedTerm*>(nested);
+		bool is_static = dynamic_cast<const UserDefinedStaticTerm*>(nested);
+
+		// Static predicates are only known to be true on the tuples of their extension
+		bool relational = constant && !variables.empty() && (fluent || (is_static && info.has_extension(nested->getSymbolId()) && (!info.isPredicate(nested->getSymbolId()) || constant->getValue() == 1)));
+
+		Relation relation{atom, relational ? nested->getSymbolId() : 0, fluent, relational ? constant->getValue() : 0, {}, {}};
+		for (const Term* subterm:(relational ? nested->getSubterms() : std::vector<const Term*>())) {
+			if (auto variable = dynamic_cast<const BoundVariable*>(subterm)) {
+				relation.variables.push_back(variable->getVariableId());
+				relation.constants.push_back(0);
+			} else if (auto argument = dynamic_cast<const Constant*>(subterm)) {
+				relation.variables.push_back(-1);
+				relation.constants.push_back(argument->getValue());
+			} else {
+				relational = false;
+				break;
+			}
+		}
+
+		if (relational) join->_relations.push_back(relation);
+		else if (variables.empty()) join->_ground.push_back(atom);
+		else filters.push_back(atom);
+	}
+
+	// Estimate the number of tuples of each relation
+	std::vector<std::size_t> sizes;
+	for (const Relation& relation:join->_relations) {
+		sizes.push_back(relation.fluent ? info.resolveStateVariable(relation.symbol).size() : info.get_extension(relation.symbol).size());
+	}
+
+	// Choose greedily the order in which relations are joined
+	std::vector<bool> bound(join->_binding_size, false), used(join->_relations.size(), false);
+	while (true) {
+		int best = -1;
+		unsigned best_key = 0;
+		for (unsigned r = 0; r < join->_relations.size(); ++r) {
+			if (used[r]) continue;
+			unsigned key = 0, unbound = 0;
+			for (int variable:join->_relations[r].variables) {
+				if (variable < 0) continue;
+				if (bound[variable]) ++key;
+				else ++unbound;
+			}
+			if (unbound == 0) continue;
+			if (best < 0 || key > best_key || (key == best_key && sizes[r] < sizes[best])) {
+				best = r;
+				best_key = key;
+			}
+		}
+		if (best < 0) break;
+		used[best] = true;
+
+		const Relation& relation = join->_relations[best];
+		Step step{best, -1, {}, 0, {}, {}};
+		for (unsigned position = 0; position < relation.variables.size(); ++position) {
+			if (relation.variables[position] >= 0 && bound[relation.variables[position]]) step.order.push_back(position);
+		}
+		step.key_size = step.order.size();
+		for (unsigned position = 0; position < relation.variables.size(); ++position) {
+			if (relation.variables[position] >= 0 && !bound[relation.variables[position]]) step.order.push_back(position);
+		}
+		for (int variable:relation.variables) {
+			if (variable >= 0) bound[variable] = true;
+		}
+		join->_steps.push_back(std::move(step));
+	}
+
+	// The relations that have not been joined are checked as filters
+	for (unsigned r = 0; r < join->_relations.size(); ++r) {
+		if (!used[r]) filters.push_back(join->_relations[r].atom);
+	}
+
+	// Variables not appearing in any relation are enumerated
+	for (const BoundVariable* variable:formula.getVariables()) {
+		if (bound[variable->getVariableId()]) continue;
+		bound[variable->getVariableId()] = true;
+		join->_steps.push_back(Step{-1, (int) variable->getVariableId(), {}, 0, {}, {}});
+	}
+
+	// Attach each filter to the first step after which all its variables are bound
+	std::vector<unsigned> bound_at(join->_binding_size, 0);
+	for (unsigned i = 0; i < join->_steps.size(); ++i) {
+		const Step& step = join->_steps[i];
+		if (step.relation < 0) {
+			bound_at[step.variable] = i;
+			continue;
+		}
+		const Relation& relation = join->_relations[step.relation];
+		for (unsigned k = step.key_size; k < step.order.size(); ++k) bound_at[relation.variables[step.order[k]]] = i;
+	}
+	for (const AtomicFormula* atom:filters) {
+		unsigned last = 0;
+		for (unsigned variable:atom_variables(atom)) last = std::max(last, bound_at[variable]);
+		join->_steps[last].filters.push_back(atom);
+	}
+
+	// Static relations are indexed once and for all
+	for (Step& step:join->_steps) {
+		if (step.relation >= 0 && !join->_relations[step.relation].fluent) join->fill_index(step, nullptr, step.index);
+	}
+
+	return join.release();
+}
+
+ExistentialJoin::~ExistentialJoin() = default;
+
+void ExistentialJoin::fill_index(const Step& step, const State* state, Index& index) const {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const Relation& relation = _relations[step.relation];
+	unsigned arity = relation.variables.size();
+	unsigned width = step.order.size();
+	index.values.clear();
+	index.rows.clear();
+
+	auto insert = [&](const ObjectIdx* arguments, ObjectIdx value) {
+		if (value != relation.value) return;
+		for (unsigned position = 0; position < arity; ++position) {
+			int variable = relation.variables[position];
+			if (variable < 0) {
+				if (arguments[position] != relation.constants[position]) return;
+				continue;
+			}
+			// The object must belong to the type of the variable, and repeated variables must take the same value
+			const auto& domain = _domains[variable];
+			if (!std::binary_search(domain.begin(), domain.end(), arguments[position])) return;
+			for (unsigned other = 0; other < position; ++other) {
+				if (relation.variables[other] == variable && arguments[other] != arguments[position]) return;
+			}
+		}
+		index.rows.push_back(index.values.size());
+		for (unsigned position:step.order) index.values.push_back(arguments[position]);
+	};
+
+	if (relation.fluent) {
+		assert(state);
+		for (VariableIdx variable:info.resolveStateVariable(relation.symbol)) {
+			insert(info.getVariableData(variable).second.data(), state->getValue(variable));
+		}
+	} else {
+		for (const ValueTuple& tuple:info.get_extension(relation.symbol).get_tuples()) {
+			assert(tuple.size() == arity + 1); // The value of the symbol is the last element of the tuple
+			insert(tuple.data(), tuple.back());
+		}
+	}
+
+	const ObjectIdx* values = index.values.data();
+	std::sort(index.rows.begin(), index.rows.end(), [values, width](unsigned a, unsigned b) {
+		return std::lexicographical_compare(values + a, values + a + width, values + b, values + b + width);
+	});
+}
+
+bool ExistentialJoin::check_filters(const Step& step, const State& state, const Binding& binding) const {
+	for (const AtomicFormula* atom:step.filters) {
+		if (!atom->interpret(state, binding)) return false;
+	}
+	return true;
+}
+
+bool ExistentialJoin::search(unsigned i, const State& state, Binding& binding, const std::vector<Index>& indexes) const {
+	if (i == _steps.size()) return true;
+	const Step& step = _steps[i];
+
+	if (step.relation < 0) {
+		for (ObjectIdx object:_domains[step.variable]) {
+			binding.set(step.variable, object);
+			if (check_filters(step, state, binding) && search(i + 1, state, binding, indexes)) return true;
+		}
+		return false;
+	}
+
+	const Relation& relation = _relations[step.relation];
+	const Index& index = relation.fluent ? indexes[i] : step.index;
+	const ObjectIdx* values = index.values.data();
+
+	// Compares the key of the given row with the values of the key variables under the current binding
+	auto compare = [&](unsigned row) {
+		for (unsigned k = 0; k < step.key_size; ++k) {
+			ObjectIdx expected = binding.value(relation.variables[step.order[k]]);
+			if (values[row + k] != expected) return values[row + k] < expected ? -1 : 1;
+		}
+		return 0;
+	};
+	auto first = std::lower_bound(index.rows.begin(), index.rows.end(), 0, [&](unsigned row, int) { return compare(row) < 0; });
+	auto last = std::upper_bound(first, index.rows.end(), 0, [&](int, unsigned row) { return compare(row) > 0; });
+
+	for (auto it = first; it != last; ++it) {
+		for (unsigned k = step.key_size; k < step.order.size(); ++k) {
+			binding.set(relation.variables[step.order[k]], values[*it + k]);
+		}
+		if (check_filters(step, state, binding) && search(i + 1, state, binding, indexes)) return true;
+	}
+	return false;
+}
+
+bool ExistentialJoin::satisfied(const State& state) const {
+	for (const AtomicFormula* atom:_ground) {
+		if (!atom->interpret(state)) return false;
+	}
+
+	std::vector<Index> indexes(_steps.size());
+	for (unsigned i = 0; i < _steps.size(); ++i) {
+		const Step& step = _steps[i];
+		if (step.relation < 0) continue;
+		if (_relations[step.relation].fluent) fill_index(step, &state, indexes[i]);
+		if ((_relations[step.relation].fluent ? indexes[i] : step.index).rows.empty()) return false;
+	}
+
+	Binding binding(_binding_size);
+	return search(0, state, binding, indexes);
+}
+
+} } } // namespaces
@@ -0,0 +1,101 @@
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <fs_types.hxx>
+
+namespace fs0 { class State; class Binding; }
+
+namespace fs0 { namespace language { namespace fstrips {
+
+class AtomicFormula;
+class Conjunction;
+class ExistentiallyQuantifiedFormula;
+
+//! Evaluates a closed, existentially quantified conjunction on a state as a backtracking join, instead of enumerating
+//! all the objects of the type of each quantified variable.
+//! Atoms of the form 'h(t_1, ..., t_n) = c', where 'h' is a fluent symbol or a static symbol with a known extension and
+//! each t_i is a quantified variable or a constant, denote relations: the tuples of 'h' with value 'c' in the current state,
+//! or in the static extension. The quantified variables are bound by a sequence of steps, each of which joins one of
+//! these relations with the variables bound by the previous steps, looking up the matching tuples in an index of the
+//! relation sorted by the positions already fixed at that point. Relations are chosen greedily, preferring those most
+//! constrained by the previous steps, and then those with fewer tuples; variables that do not appear in any relation
+//! are bound by enumerating the objects of their type. Every other atom is checked as a filter right after the step
+//! at which all its variables become bound.
+//! The join keeps its own copy of the quantified conjunction, so that it can be shared by all the copies of the formula.
+class ExistentialJoin {
+public:
+	//! Returns a join evaluator for the given formula, or a null pointer if the formula has free variables
+	static ExistentialJoin* create(const ExistentiallyQuantifiedFormula& formula);
+
+	~ExistentialJoin();
+
+	//! Returns true iff the formula holds in the given state
+	bool satisfied(const State& state) const;
+
+protected:
+	//! The relation denoted by an atom 'h(t_1, ..., t_n) = c'
+	struct Relation {
+		const AtomicFormula* atom;
+		unsigned symbol;
+		bool fluent;
+		ObjectIdx value;
+
+		//! The binding slot of the variable at each position, or -1 if the position holds the constant in 'constants'
+		std::vector<int> variables;
+		std::vector<ObjectIdx> constants;
+	};
+
+	//! The tuples of a relation, as rows of a flat array, sorted lexicographically in the order given by the 'order' of the step
+	struct Index {
+		std::vector<ObjectIdx> values;
+		std::vector<unsigned> rows;
+	};
+
+	struct Step {
+		//! The relation joined at this step, or -1 if the step enumerates the objects of the type of 'variable'
+		int relation;
+		int variable;
+
+		//! The positions of the relation, first those whose value is known when the step is reached (the 'key'),
+		//! then the rest, whose values bind variables
+		std::vector<unsigned> order;
+		unsigned key_size;
+
+		//! The atoms to check once the step has bound its variables
+		std::vector<const AtomicFormula*> filters;
+
+		//! The index of the tuples of static relations
+		Index index;
+	};
+
+	ExistentialJoin() = default;
+
+	//! The conjunction whose atoms the relations and filters refer to
+	std::unique_ptr<const Conjunction> _subformula;
+
+	std::vector<Relation> _relations;
+
+	std::vector<Step> _steps;
+
+	//! The atoms without variables
+	std::vector<const AtomicFormula*> _ground;
+
+	//! The size of the binding, i.e. the maximum quantified variable ID plus one
+	unsigned _binding_size;
+
+	//! The sorted objects of the type of each quantified variable, indexed by binding slot
+	std::vector<std::vector<ObjectIdx>> _domains;
+
+	//! Fills the index of the relation of the given step with its tuples in the given state (or in the static extension)
+	//! that match its constants and the types of its variables
+	void fill_index(const Step& step, const State* state, Index& index) const;
+
+	bool search(unsigned i, const State& state, Binding& binding, const std::vector<Index>& indexes) const;
+
+	bool check_filters(const Step& step, const State& state, const Binding& binding) const;
+};
+
+} } } // namespaces
@@ -2,6 +2,7 @@
 #include <problem_info.hxx>
 #include <languages/fstrips/formulae.hxx>
 #include <languages/fstrips/terms.hxx>
+#include <languages/fstrips/existential_join.hxx>
 #include <problem.hxx>
 #include <utils/utils.hxx>
 #include <state.hxx>
@@ -151,10 +152,23 @@ std::vector<const Formula*> Conjunction::all_formulae() const {
 	return res;
 }
 
+ExistentiallyQuantifiedFormula::ExistentiallyQuantifiedFormula(const std::vector<const BoundVariable*>& variables, const Conjunction* subformula) :
+	_variables(variables), _subformula(subformula), _join()
+{}
+
 ExistentiallyQuantifiedFormula::ExistentiallyQuantifiedFormula(const ExistentiallyQuantifiedFormula& other) :
-_variables(Utils::clone(other._variables)), _subformula(other._subformula->clone())
+_variables(Utils::clone(other._variables)), _subformula(other._subformula->clone()), _join(other._join)
 {}
 
+ExistentiallyQuantifiedFormula::~ExistentiallyQuantifiedFormula() {
+	delete _subformula;
+}
+
+bool ExistentiallyQuantifiedFormula::prepare_join() const {
+	if (!_join) _join = std::shared_ptr<const ExistentialJoin>(ExistentialJoin::create(*this));
+	return _join != nullptr;
+}
+
 std::vector<const Formula*> ExistentiallyQuantifiedFormula::all_formulae() const {
 	std::vector<const Formula*> res(1, this);
 	auto tmp = _subformula->all_formulae();
@@ -190,12 +204,19 @@ std::ostream& ExistentiallyQuantifiedFormula::print(std::ostream& os, const fs0:
 
 bool ExistentiallyQuantifiedFormula::interpret(const PartialAssignment& assignment, const Binding& binding) const {
 	assert(binding.size()==0); // ATM we do not allow for nested quantifications
-	return interpret_rec(assignment, Binding(_variables.size()), 0);
+	return interpret_rec(assignment, Binding(binding_size()), 0);
 }
 
 bool ExistentiallyQuantifiedFormula::interpret(const State& state, const Binding& binding) const {
 	assert(binding.size()==0); // ATM we do not allow for nested quantifications
-	return interpret_rec(state, Binding(_variables.size()), 0);
+	if (_join) return _join->satisfied(state);
+	return interpret_rec(state, Binding(binding_size()), 0);
+}
+
+unsigned ExistentiallyQuantifiedFormula::binding_size() const {
+	unsigned size = 0;
+	for (const BoundVariable* variable:_variables) size = std::max(size, variable->getVariableId() + 1);
+	return size;
 }
 
 template <typename T>
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 
 #include <fs_types.hxx>
 
@@ -20,6 +21,7 @@ class Conjunction;
 class ExistentiallyQuantifiedFormula;
 class Tautology;
 class Contradiction;
+class ExistentialJoin;
 
 //! The base interface for a logic formula
 class Formula {
@@ -209,11 +211,9 @@ class ExistentiallyQuantifiedFormula : public Formula {
 public:
 	friend class LogicalOperations;
 	
-	ExistentiallyQuantifiedFormula(const std::vector<const BoundVariable*>& variables, const Conjunction* subformula) : _variables(variables), _subformula(subformula) {}
+	ExistentiallyQuantifiedFormula(const std::vector<const BoundVariable*>& variables, const Conjunction* subformula);
 	
-	virtual ~ExistentiallyQuantifiedFormula() {
-		delete _subformula;
-	}
+	virtual ~ExistentiallyQuantifiedFormula();
 	
 	ExistentiallyQuantifiedFormula(const ExistentiallyQuantifiedFormula& other);
 	
@@ -223,6 +223,13 @@ public:
 	
 	const Conjunction* getSubformula() const { return _subformula; }
 	
+	const std::vector<const BoundVariable*>& getVariables() const { return _variables; }
+	
+	//! Builds the join through which the formula is evaluated on states (see ExistentialJoin), unless it was already built.
+	//! Returns false iff the formula is not closed, in which case it is evaluated by enumerating the quantified variables.
+	//! Meant to be called once, before the search, on the formulas to be evaluated on many states.
+	bool prepare_join() const;
+	
 	bool interpret(const PartialAssignment& assignment, const Binding& binding) const;
 	bool interpret(const State& state, const Binding& binding) const;
 	
@@ -245,6 +252,12 @@ protected:
 	//! ATM we only allow quantification of conjunctions
 	const Conjunction* _subformula;
 	
+	//! The join-based evaluator of the formula, if it has been prepared, which is shared with the copies of the formula
+	mutable std::shared_ptr<const ExistentialJoin> _join;
+	
+	//! The size of a binding able to hold all the quantified variables, whose IDs need not start at zero
+	unsigned binding_size() const;
+	
 	//! A naive recursive implementation of the interpretation routine
 	template <typename T>
 	bool interpret_rec(const T& assignment, const Binding& binding, unsigned i) const;
@@ -168,11 +168,22 @@ std::pair<int, int> UserDefinedStaticTerm::getBounds() const {
 }
 
 ObjectIdx UserDefinedStaticTerm::interpret(const PartialAssignment& assignment, const Binding& binding) const {
-	return _function.getFunction()(interpret_subterms(_subterms, assignment, binding));
+	const DenseExtension* dense = _function.getDenseExtension();
+	if (!dense) return _function.getFunction()(interpret_subterms(_subterms, assignment, binding));
+	
+	ObjectIdx arguments[DenseExtension::MAX_ARITY];
+	for (unsigned i = 0; i < _subterms.size(); ++i) arguments[i] = _subterms[i]->interpret(assignment, binding);
+	return dense->value(arguments);
 }
 
 ObjectIdx UserDefinedStaticTerm::interpret(const State& state, const Binding& binding) const {
-	return _function.getFunction()(interpret_subterms(_subterms, state, binding));
+	// Symbols with a dense extension are evaluated by direct indexing, with no heap allocation
+	const DenseExtension* dense = _function.getDenseExtension();
+	if (!dense) return _function.getFunction()(interpret_subterms(_subterms, state, binding));
+	
+	ObjectIdx arguments[DenseExtension::MAX_ARITY];
+	for (unsigned i = 0; i < _subterms.size(); ++i) arguments[i] = _subterms[i]->interpret(state, binding);
+	return dense->value(arguments);
 }
 
 ObjectIdx FluentHeadedNestedTerm::interpret(const PartialAssignment& assignment, const Binding& binding) const {
@@ -183,15 +194,22 @@ ObjectIdx FluentHeadedNestedTerm::interpret(const State& state, const Binding& b
 	return state.getValue(interpretVariable(state, binding));
 }
 
-VariableIdx FluentHeadedNestedTerm::interpretVariable(const PartialAssignment& assignment, const Binding& binding) const {
+template <typename T>
+VariableIdx FluentHeadedNestedTerm::resolve(const T& assignment, const Binding& binding) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
-	VariableIdx variable = info.resolveStateVariable(_symbol_id, interpret_subterms(_subterms, assignment, binding));
-	return variable;
+	unsigned arity = _subterms.size();
+	if (arity > MAX_STACK_ARITY) return info.resolveStateVariable(_symbol_id, interpret_subterms(_subterms, assignment, binding));
+	
+	ObjectIdx arguments[MAX_STACK_ARITY];
+	for (unsigned i = 0; i < arity; ++i) arguments[i] = _subterms[i]->interpret(assignment, binding);
+	return info.resolveStateVariable(_symbol_id, arguments, arity);
+}
+
+VariableIdx FluentHeadedNestedTerm::interpretVariable(const PartialAssignment& assignment, const Binding& binding) const {
+	return resolve(assignment, binding);
 }
 VariableIdx FluentHeadedNestedTerm::interpretVariable(const State& state, const Binding& binding) const {
-	const ProblemInfo& info = ProblemInfo::getInstance();
-	VariableIdx variable = info.resolveStateVariable(_symbol_id, interpret_subterms(_subterms, state, binding));
-	return variable;
+	return resolve(state, binding);
 }
 
 std::pair<int, int> FluentHeadedNestedTerm::getBounds() const {
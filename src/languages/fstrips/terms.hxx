@@ -213,6 +213,14 @@ public:
 
 	// A nested term headed by a fluent symbol has as many levels of nestedness as the maximum of its subterms plus one (standing for itself)
 	unsigned nestedness() const { return maxSubtermNestedness() + 1; }
+
+protected:
+	//! The maximum arity for which the subterms are interpreted into a stack-allocated array
+	static const unsigned MAX_STACK_ARITY = 8;
+
+	//! Resolves the state variable denoted by the term without allocating memory for the values of the subterms
+	template <typename T>
+	VariableIdx resolve(const T& assignment, const Binding& binding) const;
 };
 
 //! A logical variable bound to some existential or universal quantifier
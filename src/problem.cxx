@@ -6,6 +6,7 @@
 #include <utils/printers/language.hxx>
 #include <utils/printers/actions.hxx>
 #include <applicability/formula_interpreter.hxx>
+#include <applicability/successor_generator.hxx>
 
 namespace fs0 {
 
@@ -16,6 +17,7 @@ Problem::Problem(State* init, const std::vector<const ActionData*>& action_data,
 	_init(init),
 	_action_data(action_data),
 	_ground(),
+	_successor_generator(),
 	_partials(),
 	_state_constraint_formula(state_constraints),
 	_goal_formula(goal),
@@ -32,6 +34,12 @@ Problem::~Problem() {
 	delete _goal_formula;
 }
 
+void Problem::setGroundActions(std::vector<const GroundAction*>&& ground) {
+	_ground = std::move(ground);
+	_successor_generator = std::unique_ptr<SuccessorGenerator>(new SuccessorGenerator(_ground));
+	LPT_INFO("main", "Successor generator built: " << *_successor_generator);
+}
+
 std::ostream& Problem::print(std::ostream& os) const { 
 	const fs0::ProblemInfo& info = ProblemInfo::getInstance();
 	os << "Planning Problem [domain: " << info.getDomainName() << ", instance: " << info.getInstanceName() <<  "]" << std::endl;
@@ -16,6 +16,7 @@ class ActionData;
 class ActionBase;
 class PartiallyGroundedAction;
 class GroundAction;
+class SuccessorGenerator;
 
 class Problem {
 public:
@@ -37,7 +38,13 @@ public:
 	
 	//! Get the set of ground actions of the problem
 	const std::vector<const GroundAction*>& getGroundActions() const { return _ground; }
-	void setGroundActions(std::vector<const GroundAction*>&& ground) { _ground = std::move(ground); }
+	//! Setting the ground actions triggers the construction of the successor generator over them
+	void setGroundActions(std::vector<const GroundAction*>&& ground);
+	//! Whether the ground actions of the problem have already been set
+	bool hasGroundActions() const { return _successor_generator != nullptr; }
+	
+	//! The successor generator indexing the ground actions of the problem
+	const SuccessorGenerator& getSuccessorGenerator() const { assert(_successor_generator); return *_successor_generator; }
 	
 	const std::vector<const PartiallyGroundedAction*>& getPartiallyGroundedActions() const { return _partials; }
 	void setPartiallyGroundedActions(std::vector<const PartiallyGroundedAction*>&& actions) { _partials = std::move(actions); }
@@ -86,6 +93,9 @@ protected:
 	// The set of grounded actions of the problem
 	std::vector<const GroundAction*> _ground;
 	
+	//! The successor generator indexing the set of grounded actions
+	std::unique_ptr<SuccessorGenerator> _successor_generator;
+	
 	// The possible set of partially grounded actions of the problem
 	std::vector<const PartiallyGroundedAction*> _partials;
 	
@@ -37,6 +37,11 @@ ProblemInfo::ProblemInfo(const rapidjson::Document& data) {
 	}
 	
 	_extensions.resize(getNumLogicalSymbols());
+	
+	buildVariableIndexes();
+	
+	_state_layout = std::unique_ptr<StateLayout>(new StateLayout(*this));
+	LPT_INFO("main", "State packing: " << *_state_layout);
 }
 
 const std::string& ProblemInfo::getVariableName(VariableIdx index) const { return variableNames.at(index); }
@@ -212,6 +217,55 @@ bool ProblemInfo::checkValueIsValid(VariableIdx variable, ObjectIdx value) const
 }
 
 
+void ProblemInfo::buildVariableIndexes() {
+	_variable_indexes.resize(getNumLogicalSymbols());
+	for (unsigned symbol = 0; symbol < getNumLogicalSymbols(); ++symbol) {
+		const SymbolData& data = getSymbolData(symbol);
+		if (data.isStatic()) continue;
+		
+		VariableIndex& index = _variable_indexes[symbol];
+		const std::vector<VariableIdx>& variables = data.getStateVariables();
+		unsigned arity = data.getArity();
+		
+		// Compute the range of objects of each argument position
+		index.min.assign(arity, std::numeric_limits<long>::max());
+		std::vector<long> max(arity, std::numeric_limits<long>::min());
+		for (VariableIdx variable:variables) {
+			const std::vector<ObjectIdx>& arguments = getVariableData(variable).second;
+			assert(arguments.size() == arity);
+			for (unsigned i = 0; i < arity; ++i) {
+				index.min[i] = std::min(index.min[i], static_cast<long>(arguments[i]));
+				max[i] = std::max(max[i], static_cast<long>(arguments[i]));
+			}
+		}
+		
+		// The last argument position is the one that varies faster
+		std::size_t size = 1;
+		bool too_large = false;
+		index.extent.resize(arity);
+		index.stride.resize(arity);
+		for (int i = arity - 1; i >= 0; --i) {
+			index.extent[i] = variables.empty() ? 0 : static_cast<std::size_t>(max[i] - index.min[i] + 1);
+			index.stride[i] = size;
+			too_large = too_large || (index.extent[i] > 0 && size > MAX_VARIABLE_INDEX_SIZE / index.extent[i]);
+			if (!too_large) size *= index.extent[i];
+		}
+		if (too_large) {
+			LPT_INFO("main", "State variables of symbol " << getSymbolName(symbol) << " are too sparse to be indexed densely");
+			continue;
+		}
+		
+		index.variables.assign(size, INVALID_VARIABLE);
+		index.dense = true;
+		for (VariableIdx variable:variables) {
+			const std::vector<ObjectIdx>& arguments = getVariableData(variable).second;
+			std::size_t position = 0;
+			for (unsigned i = 0; i < arity; ++i) position += (arguments[i] - index.min[i]) * index.stride[i];
+			index.variables[position] = variable;
+		}
+	}
+}
+
 void ProblemInfo::loadProblemMetadata(const rapidjson::Value& data) {
 	setDomainName(data["domain"].GetString());
 	setInstanceName(data["instance"].GetString());
@@ -221,6 +275,10 @@ void
 ProblemInfo::set_extension(unsigned symbol_id, std::unique_ptr<StaticExtension>&& extension) {
 	assert(_extensions.at(symbol_id) == nullptr); // Shouldn't be setting twice the same extension
 	setFunction(symbol_id, extension->get_function());
+	
+	const SymbolData& data = getSymbolData(symbol_id);
+	std::shared_ptr<const DenseExtension> dense(DenseExtension::build(extension->get_tuples(), data.getArity(), data.getType() == SymbolData::Type::PREDICATE));
+	functionData.at(symbol_id).setDenseExtension(dense);
 	_extensions.at(symbol_id) = std::move(extension);
 }
 
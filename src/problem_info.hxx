@@ -6,6 +6,7 @@
 
 #include <lib/rapidjson/document.h>
 #include <utils/static.hxx>
+#include <state_layout.hxx>
 
 namespace fs0 {
 
@@ -37,11 +38,17 @@ public:
 	void setFunction(const Function& function) {
 		assert(_static);
 		_function = function;
+		_dense.reset(); // Any previous dense table no longer corresponds to the function
 	}
 	const Function& getFunction() const { 
 		assert(_function);
 		return _function;
 	}
+	
+	//! Sets/Gets the dense table of the symbol extension, if any, which allows evaluating the symbol
+	//! by direct indexing, without going through the std::function nor allocating a tuple of arguments.
+	void setDenseExtension(std::shared_ptr<const DenseExtension> dense) { _dense = dense; }
+	const DenseExtension* getDenseExtension() const { return _dense.get(); }
 
 protected:
 	Type _type;
@@ -52,6 +59,9 @@ protected:
 	
 	//! The actual implementation of the function
 	Function _function;
+	
+	//! The dense table of the symbol extension, if available
+	std::shared_ptr<const DenseExtension> _dense;
 };
 
 /**
@@ -87,6 +97,24 @@ protected:
 	std::map<std::pair<unsigned, std::vector<ObjectIdx>>, VariableIdx> variableDataToId;
 	std::vector<std::pair<unsigned, std::vector<ObjectIdx>>> variableIdToData;
 	
+	//! A mixed-radix index of the state variables of a fluent symbol f: each argument position of f ranges over the
+	//! interval of objects that appear in that position in some state variable f(o_1, ..., o_n), and the variable
+	//! f(o_1, ..., o_n) is stored in the position sum_i (o_i - min_i) * stride_i of a flat array.
+	struct VariableIndex {
+		//! Whether the index is available; otherwise, variables are resolved through 'variableDataToId'
+		bool dense = false;
+		std::vector<long> min;
+		std::vector<std::size_t> extent;
+		std::vector<std::size_t> stride;
+		std::vector<VariableIdx> variables; // INVALID_VARIABLE where there is no state variable
+	};
+	
+	//! The maximum number of entries that we are willing to allocate for a single variable index
+	static const std::size_t MAX_VARIABLE_INDEX_SIZE = 1 << 24;
+	
+	//! The variable index of each logical symbol (not available for static symbols)
+	std::vector<VariableIndex> _variable_indexes;
+	
 	//! A map from state variable index to the type of the state variable
 	std::vector<ObjectType> variableGenericTypes;
 	
@@ -121,9 +149,15 @@ protected:
 	std::string _domain;
 	std::string _instance_name;
 	
+	//! The directory with the problem data
+	std::string _data_dir;
+	
 	//! The extensions of the static symbols
 	std::vector<std::unique_ptr<StaticExtension>> _extensions;
 	
+	//! The layout of packed states, computed once all variables have been loaded
+	std::unique_ptr<StateLayout> _state_layout;
+	
 public:
 	ProblemInfo(const rapidjson::Document& data);
 	~ProblemInfo() = default;
@@ -150,6 +184,9 @@ public:
 	bool isFunction(unsigned symbol_id) const { return getSymbolData(symbol_id).getType() == SymbolData::Type::FUNCTION; }
 	
 	bool isPredicativeVariable(VariableIdx variable) const { return _predicative_variables.at(variable); }
+	
+	//! The layout according to which all states are packed
+	const StateLayout& getStateLayout() const { return *_state_layout; }
 	bool isNegatedPredicativeAtom(const Atom& atom) const;
 	
 	void setFunction(unsigned functionId, const Function& function) {
@@ -161,6 +198,9 @@ public:
 	void set_extension(unsigned symbol_id, std::unique_ptr<StaticExtension>&& extension);
 	const StaticExtension& get_extension(unsigned symbol_id) const;
 	
+	//! Whether the given symbol has a loaded static extension (externally-defined symbols, for instance, don't)
+	bool has_extension(unsigned symbol_id) const { return _extensions.at(symbol_id) != nullptr; }
+	
 	//! A convenient helper
 	template <typename ExtensionT>
 	const ExtensionT& get_extension(const std::string& symbol) const {
@@ -193,8 +233,28 @@ public:
 	
 	
 	//! Resolves a pair of function ID + an assignment of values to their parameters to the corresponding state variable.
-	VariableIdx resolveStateVariable(unsigned symbol_id, std::vector<ObjectIdx>&& constants) const { return variableDataToId.at(std::make_pair(symbol_id, constants)); }
-	VariableIdx resolveStateVariable(unsigned symbol_id, const std::vector<ObjectIdx>& constants) const { return variableDataToId.at(std::make_pair(symbol_id, constants)); }
+	//! Throws std::out_of_range if there is no such state variable.
+	VariableIdx resolveStateVariable(unsigned symbol_id, std::vector<ObjectIdx>&& constants) const { return resolveStateVariable(symbol_id, constants.data(), constants.size()); }
+	VariableIdx resolveStateVariable(unsigned symbol_id, const std::vector<ObjectIdx>& constants) const { return resolveStateVariable(symbol_id, constants.data(), constants.size()); }
+	
+	//! Resolves the state variable f(o_1, ..., o_n) given an array with the n objects o_1, ..., o_n. In general, this
+	//! amounts to a few arithmetic operations, with no memory allocation.
+	VariableIdx resolveStateVariable(unsigned symbol_id, const ObjectIdx* constants, unsigned arity) const {
+		const VariableIndex& index = _variable_indexes[symbol_id];
+		if (!index.dense) return variableDataToId.at(std::make_pair(symbol_id, std::vector<ObjectIdx>(constants, constants + arity)));
+		assert(arity == index.extent.size());
+		
+		std::size_t position = 0;
+		for (unsigned i = 0; i < arity; ++i) {
+			// A single unsigned comparison checks both bounds
+			std::size_t offset = static_cast<std::size_t>(static_cast<long>(constants[i]) - index.min[i]);
+			if (offset >= index.extent[i]) throw std::out_of_range("No such state variable");
+			position += offset * index.stride[i];
+		}
+		VariableIdx variable = index.variables[position];
+		if (variable == INVALID_VARIABLE) throw std::out_of_range("No such state variable");
+		return variable;
+	}
 	
 	//! Return the data that originated a state variable
 	const std::pair<unsigned, std::vector<ObjectIdx>>& getVariableData(VariableIdx variable) const { return variableIdToData.at(variable); }
@@ -229,6 +289,9 @@ public:
 	const std::string& getDomainName() const { return _domain; }
 	const std::string& getInstanceName() const { return _instance_name; }
 	
+	void setDataDir(const std::string& data_dir) { _data_dir = data_dir; }
+	const std::string& getDataDir() const { return _data_dir; }
+	
 	//! Returns the generic type (object, int, bool, etc.) corresponding to a concrete type
 	ObjectType getGenericType(TypeIdx typeId) const;
 	ObjectType getGenericType(const std::string& type) const;
@@ -248,6 +311,9 @@ protected:
 	
 	void loadProblemMetadata(const rapidjson::Value& data);
 	
+	//! Builds the mixed-radix index of state variables of each fluent symbol
+	void buildVariableIndexes();
+	
 	std::vector<bool> _predicative_variables;
 };
 
@@ -0,0 +1,102 @@
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <unordered_set>
+
+#include <aptk2/tools/logging.hxx>
+
+#include <search/drivers/registry.hxx>
+#include <search/nodes/heuristic_search_node.hxx>
+#include <ground_state_model.hxx>
+#include <actions/ground_action_iterator.hxx>
+#include <utils/thread_pool.hxx>
+#include <state.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! A Greedy Best-First Search where all the successors of an expanded node are generated first, then evaluated concurrently
+//! by a pool of threads, each with its own heuristic instance, and finally pushed into the open list in the order in which
+//! they were generated. Since heuristic values do not depend on which heuristic instance computes them, the search is exactly
+//! the same, and visits nodes in exactly the same order, regardless of the number of threads.
+//! Search nodes are created, and their states interned, by the main thread only.
+template <typename HeuristicT>
+class BatchParallelGBFS : public FS0SearchAlgorithm {
+public:
+	typedef HeuristicSearchNode<State, GroundAction> SearchNode;
+	typedef std::shared_ptr<SearchNode> NodePtr;
+
+	//! The number of threads is given by the number of heuristics
+	BatchParallelGBFS(const GroundStateModel& model, std::vector<std::unique_ptr<HeuristicT>>&& heuristics) :
+		FS0SearchAlgorithm(model), _heuristics(std::move(heuristics)), _pool(_heuristics.size())
+	{
+		assert(!_heuristics.empty());
+	}
+
+	virtual ~BatchParallelGBFS() = default;
+
+	BatchParallelGBFS(const BatchParallelGBFS&) = delete;
+	BatchParallelGBFS& operator=(const BatchParallelGBFS&) = delete;
+
+	virtual bool search(const State& state, typename FS0SearchAlgorithm::Plan& solution) {
+		LPT_INFO("main", "Starting GBFS with batch heuristic evaluation on " << _pool.size() << " threads");
+		std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+		std::unordered_set<StateIdx> seen; // States are interned, hence we can identify them by their index
+		unsigned long order = 0;
+
+		NodePtr root = std::make_shared<SearchNode>(state);
+		root->evaluate_with(*_heuristics[0]);
+		seen.insert(root->state.index());
+		if (!root->dead_end()) open.push(OpenEntry{root, order++});
+
+		std::vector<NodePtr> children;
+		std::vector<const State*> states;
+		while (!open.empty()) {
+			NodePtr node = open.top().node;
+			open.pop();
+
+			if (this->model.goal(node->state)) {
+				for (const SearchNode* current = node.get(); current->has_parent(); current = current->parent.get()) solution.push_back(current->action);
+				std::reverse(solution.begin(), solution.end());
+				return true;
+			}
+
+			++this->expanded;
+			children.clear();
+			for (const auto& action:this->model.applicable_actions(node->state)) {
+				NodePtr child = std::make_shared<SearchNode>(this->model.next(node->state, action), action, node);
+				if (seen.insert(child->state.index()).second) children.push_back(child);
+			}
+
+			// States are resolved here, since the workers cannot resolve them against the state registry of this thread
+			states.clear();
+			for (const NodePtr& child:children) states.push_back(&child->state.get());
+			_pool.run(children.size(), [this, &children, &states](unsigned worker, unsigned i) {
+				children[i]->h = _heuristics[worker]->evaluate(*states[i]);
+			});
+
+			for (const NodePtr& child:children) {
+				++this->generated;
+				if (!child->dead_end()) open.push(OpenEntry{child, order++});
+			}
+		}
+		return false;
+	}
+
+protected:
+	//! An entry of the open list, ordered by heuristic value and then in FIFO order
+	struct OpenEntry {
+		NodePtr node;
+		unsigned long order;
+		bool operator>(const OpenEntry& other) const { return node->h > other.node->h || (node->h == other.node->h && order > other.order); }
+	};
+
+	//! The heuristic instance used by each of the workers of the pool
+	std::vector<std::unique_ptr<HeuristicT>> _heuristics;
+
+	ThreadPool _pool;
+};
+
+} } // namespaces
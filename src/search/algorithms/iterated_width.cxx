@@ -1,12 +1,13 @@
 
 #include <search/algorithms/iterated_width.hxx>
 #include <actions/ground_action_iterator.hxx>
+#include <state_registry.hxx>
 
 
 namespace fs0 { namespace drivers {
 
 FS0IWAlgorithm::FS0IWAlgorithm(const GroundStateModel& model, unsigned initial_max_width, unsigned final_max_width, const NoveltyFeaturesConfiguration& feature_configuration)
-	: FS0SearchAlgorithm(model), _current_max_width(initial_max_width), _final_max_width(final_max_width), _feature_configuration(feature_configuration)
+	: FS0SearchAlgorithm(model), _algorithm(nullptr), _current_max_width(initial_max_width), _final_max_width(final_max_width), _feature_configuration(feature_configuration)
 {
 	setup_base_algorithm(_current_max_width);
 }
@@ -27,7 +28,13 @@ bool FS0IWAlgorithm::search(const State& state, typename FS0SearchAlgorithm::Pla
 }
 
 void FS0IWAlgorithm::setup_base_algorithm(unsigned max_width) {
-	if (_algorithm) delete _algorithm;
+	if (_algorithm) {
+		// The nodes of the previous iteration are gone, hence so can go their states. Clearing the registry invalidates
+		// every StateRef, but the nodes were the only holders of them: the state that 'search' starts from is a copy
+		// owned by the caller. Debug builds check that no StateRef is resolved after the registry was cleared.
+		delete _algorithm;
+		StateRegistry::instance().clear();
+	}
 	std::shared_ptr<SearchNoveltyEvaluator> evaluator = std::make_shared<SearchNoveltyEvaluator>(this->model, _current_max_width, _feature_configuration);
 	_algorithm = new BaseAlgorithm(model, OpenList(evaluator));
 }
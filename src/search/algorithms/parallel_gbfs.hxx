@@ -0,0 +1,240 @@
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
+
+#include <aptk2/tools/logging.hxx>
+
+#include <search/drivers/registry.hxx>
+#include <ground_state_model.hxx>
+#include <applicability/formula_interpreter.hxx>
+#include <actions/ground_action_iterator.hxx>
+#include <problem.hxx>
+#include <state.hxx>
+
+namespace fs0 { namespace drivers {
+
+//! A multi-threaded Greedy Best-First Search based on hash-distributed search (HDA*, Kishimoto et al.).
+//! The state space is partitioned among the worker threads according to the hash of each state: every worker
+//! owns an open list and a closed list for the states of its partition, evaluates their heuristic value with
+//! its own heuristic instance, and sends each successor it generates to the inbox of the worker that owns it.
+//! Workers do not share any state registry nor any search node besides the (immutable) parent pointers
+//! that are used to reconstruct the plan once the search is over.
+//! Unlike the sequential GBFS, the order in which nodes are expanded depends on thread scheduling,
+//! hence the search is not deterministic and the plan found might differ from one run to another.
+template <typename HeuristicT>
+class ParallelGBFS : public FS0SearchAlgorithm {
+public:
+	//! The search uses one heuristic instance per worker thread; the number of threads is given by the number of heuristics
+	ParallelGBFS(const GroundStateModel& model, std::vector<std::unique_ptr<HeuristicT>>&& heuristics) :
+		FS0SearchAlgorithm(model), _workers(), _solution(nullptr), _finished(false), _outstanding(0)
+	{
+		assert(!heuristics.empty());
+		for (auto& heuristic:heuristics) _workers.push_back(std::unique_ptr<Worker>(new Worker(model, std::move(heuristic))));
+	}
+
+	virtual ~ParallelGBFS() = default;
+
+	ParallelGBFS(const ParallelGBFS&) = delete;
+	ParallelGBFS& operator=(const ParallelGBFS&) = delete;
+
+	virtual bool search(const State& state, typename FS0SearchAlgorithm::Plan& solution) {
+		LPT_INFO("main", "Starting parallel GBFS with " << _workers.size() << " threads");
+		_solution = nullptr;
+		_finished = false;
+		_outstanding = 1;
+		send(Message{State(state), GroundAction::invalid_action_id, nullptr, 0});
+
+		std::vector<std::thread> threads;
+		std::vector<std::exception_ptr> errors(_workers.size());
+		for (unsigned i = 0; i < _workers.size(); ++i) {
+			threads.push_back(std::thread([this, i, &errors]() {
+				try { run(*_workers[i]); }
+				catch (...) { errors[i] = std::current_exception(); finish(nullptr); }
+			}));
+		}
+		for (std::thread& thread:threads) thread.join();
+		for (const std::exception_ptr& error:errors) if (error) std::rethrow_exception(error);
+
+		this->generated = 0;
+		this->expanded = 0;
+		for (const auto& worker:_workers) {
+			this->generated += worker->generated;
+			this->expanded += worker->expanded;
+		}
+
+		if (!_solution) return false;
+		for (const Node* node = _solution; node->parent != nullptr; node = node->parent) solution.push_back(node->action);
+		std::reverse(solution.begin(), solution.end());
+		return true;
+	}
+
+protected:
+	//! A search node, which once created is owned by the worker of its partition and never modified
+	struct Node {
+		State state;
+		ActionIdx action;
+		const Node* parent;
+		unsigned g;
+		long h;
+	};
+
+	//! A successor generated by some worker and sent to the worker owning its state
+	struct Message {
+		State state;
+		ActionIdx action;
+		const Node* parent;
+		unsigned g;
+	};
+
+	struct NodeHash {
+		std::size_t operator()(const Node* node) const { return node->state.hash(); }
+	};
+
+	struct NodeEqual {
+		bool operator()(const Node* n1, const Node* n2) const { return n1->state == n2->state; }
+	};
+
+	//! An entry of the open list, ordered by heuristic value and then in FIFO order
+	struct OpenEntry {
+		long h;
+		unsigned long order;
+		const Node* node;
+		bool operator>(const OpenEntry& other) const { return h > other.h || (h == other.h && order > other.order); }
+	};
+
+	struct Worker {
+		Worker(const GroundStateModel& model_, std::unique_ptr<HeuristicT>&& heuristic_) :
+			model(model_.getTask()), // No incremental applicability, whose tracking is not thread-safe
+			goal(FormulaInterpreter::create(model_.getTask().getGoalConditions(), model_.getTask().get_tuple_index())),
+			heuristic(std::move(heuristic_)), generated(0), expanded(0), order(0)
+		{
+			model.set_stop_flag(model_.get_stop_flag());
+		}
+
+		//! Each worker has its own model and goal checker, as goal checking might involve (non-reentrant) CSPs
+		GroundStateModel model;
+		std::unique_ptr<FormulaInterpreter> goal;
+		std::unique_ptr<HeuristicT> heuristic;
+
+		//! The nodes owned by the worker. A deque guarantees that nodes are never moved.
+		std::deque<Node> nodes;
+		std::unordered_set<const Node*, NodeHash, NodeEqual> closed;
+		std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+
+		//! The successors sent by other workers and not yet processed
+		std::mutex inbox_mutex;
+		std::condition_variable inbox_cv;
+		std::vector<Message> inbox;
+
+		unsigned long generated;
+		unsigned long expanded;
+		unsigned long order;
+	};
+
+	std::vector<std::unique_ptr<Worker>> _workers;
+
+	//! The goal node found by some worker, if any
+	const Node* _solution;
+	std::mutex _solution_mutex;
+
+	std::atomic<bool> _finished;
+
+	//! The number of messages sent but not yet processed plus the number of nodes in all open lists. Since the successors
+	//! of a node are accounted for before the node itself leaves the open list, the counter only drops to zero when the
+	//! whole search space has been explored.
+	std::atomic<long> _outstanding;
+
+	Worker& owner(const State& state) const { return *_workers[state.hash() % _workers.size()]; }
+
+	void send(Message&& message) {
+		Worker& worker = owner(message.state);
+		{
+			std::lock_guard<std::mutex> lock(worker.inbox_mutex);
+			worker.inbox.push_back(std::move(message));
+		}
+		worker.inbox_cv.notify_one();
+	}
+
+	void finish(const Node* solution) {
+		{
+			std::lock_guard<std::mutex> lock(_solution_mutex);
+			if (_finished) return;
+			_solution = solution;
+			_finished = true;
+		}
+		for (const auto& worker:_workers) worker->inbox_cv.notify_all();
+	}
+
+	void run(Worker& worker) {
+		std::vector<Message> received;
+		while (!_finished) {
+			{
+				std::unique_lock<std::mutex> lock(worker.inbox_mutex);
+				if (worker.inbox.empty() && worker.open.empty()) {
+					// Nothing to do: wait for some message, or for the whole search to be over
+					if (_outstanding == 0) { lock.unlock(); finish(nullptr); break; }
+					worker.inbox_cv.wait_for(lock, std::chrono::milliseconds(1));
+				}
+				received.swap(worker.inbox);
+			}
+
+			for (Message& message:received) {
+				if (_finished) break;
+				process(worker, std::move(message));
+			}
+			received.clear();
+
+			if (!_finished && !worker.open.empty()) expand(worker);
+		}
+	}
+
+	//! Registers a received successor in the worker's partition, evaluating it if it has not been seen before
+	void process(Worker& worker, Message&& message) {
+		worker.nodes.push_back(Node{std::move(message.state), message.action, message.parent, message.g, 0});
+		Node& node = worker.nodes.back();
+
+		if (!worker.closed.insert(&node).second) { // A duplicate
+			worker.nodes.pop_back();
+			--_outstanding;
+			return;
+		}
+		++worker.generated;
+
+		if (worker.goal->satisfied(node.state)) {
+			finish(&node);
+			return;
+		}
+
+		node.h = worker.heuristic->evaluate(node.state);
+		if (node.h == -1) { // A dead end
+			--_outstanding;
+			return;
+		}
+		worker.open.push(OpenEntry{node.h, worker.order++, &node});
+	}
+
+	void expand(Worker& worker) {
+		const Node* node = worker.open.top().node;
+		worker.open.pop();
+		++worker.expanded;
+		LPT_DEBUG("search", "Expanding node " << node->state << " with h = " << node->h);
+
+		for (ActionIdx action:worker.model.applicable_actions(node->state)) {
+			++_outstanding;
+			send(Message{worker.model.next(node->state, action), action, node, node->g + 1});
+		}
+		--_outstanding;
+	}
+};
+
+} } // namespaces
@@ -5,6 +5,7 @@
 #include <ground_state_model.hxx>
 #include <aptk2/tools/logging.hxx>
 #include <heuristics/novelty/fs0_novelty_evaluator.hxx>
+#include <state_registry.hxx>
 
 namespace fs0 { class Problem; class Config; }
 
@@ -33,9 +34,12 @@ public:
 
 	inline unsigned novelty(const State& state) { return evaluator(state).evaluate(state); }
 
-	//! Returns false iff we want to prune this node during the search
+	//! Returns false iff we want to prune this node during the search.
+	//! The open list discards pruned nodes right away, hence their states can leave the registry too, unless they are shared.
 	bool accept(const SearchNode& n) {
-		return novelty(n.state) <= novelty_bound();
+		if (novelty(n.state) <= novelty_bound()) return true;
+		StateRegistry::instance().release(n.state.index());
+		return false;
 	}
 };
 
@@ -8,6 +8,7 @@
 #include <heuristics/relaxed_plan/gecode_crpg.hxx>
 #include <heuristics/relaxed_plan/unreached_atom_rpg.hxx>
 #include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/cached_heuristic.hxx>
 #include <constraints/gecode/handlers/ground_action_csp.hxx>
 #include <constraints/gecode/handlers/ground_effect_csp.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
@@ -37,12 +38,12 @@ std::unique_ptr<FS0SearchAlgorithm> GBFSConstrainedHeuristicsCreator::create(con
 	ExtensionHandler extension_handler(problem.get_tuple_index(), managed);
 	
 	if (config.getHeuristic() == "hff") {
-		GecodeCRPG heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
-		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, GecodeCRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+		CachedHeuristic<GecodeCRPG> heuristic(GecodeCRPG(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler), config.getHeuristicCacheSize());
+		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, CachedHeuristic<GecodeCRPG>, GroundStateModel>(model, std::move(heuristic), delayed));
 	} else {
-		assert(config.getHeuristic() == "hmax");
-		GecodeCHMax heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler);
-		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, GecodeCHMax, GroundStateModel>(model, std::move(heuristic), delayed));
+		if (config.getHeuristic() != "hmax") throw std::runtime_error("Heuristic \"" + config.getHeuristic() + "\" is only supported by the native driver on STRIPS-like problems");
+		CachedHeuristic<GecodeCHMax> heuristic(GecodeCHMax(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler), config.getHeuristicCacheSize());
+		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, CachedHeuristic<GecodeCHMax>, GroundStateModel>(model, std::move(heuristic), delayed));
 	}
 }
 
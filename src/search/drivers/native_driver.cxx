@@ -9,6 +9,8 @@
 #include <constraints/direct/direct_rpg_builder.hxx>
 #include <constraints/direct/action_manager.hxx>
 #include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <heuristics/relaxed_plan/propositional_rpg.hxx>
+#include <heuristics/cached_heuristic.hxx>
 #include <languages/fstrips/formulae.hxx>
 
 
@@ -20,21 +22,38 @@ NativeDriver::create(const Config& config, const GroundStateModel& model) const
 	const Problem& problem = model.getTask();
 	const std::vector<const GroundAction*>& actions = problem.getGroundActions();
 	bool delayed = config.useDelayedEvaluation();
+	
+	// STRIPS-like problems are better served by the dedicated propositional engine
+	if (PropositionalRPG::is_supported(problem)) {
+		LPT_INFO("main", "Using the propositional relaxation engine with heuristic " << config.getHeuristic());
+		CachedHeuristic<PropositionalRPG> heuristic(PropositionalRPG(problem, PropositionalRPG::parse_type(config.getHeuristic())), config.getHeuristicCacheSize());
+		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, CachedHeuristic<PropositionalRPG>, GroundStateModel>(model, std::move(heuristic), delayed));
+	}
 
 	if (!check_supported(problem)) {
 		throw std::runtime_error("The Native Driver cannot process the given problem");
 	}
 	
+	// The direct CSP-based relaxation only offers the hff and hmax heuristics
+	const std::string& name = config.getHeuristic();
+	if (name == "hadd") {
+		throw std::runtime_error("The Native Driver supports the 'hadd' heuristic only on propositional problems, use either 'hff' or 'hmax'");
+	}
+	
 	auto direct_builder = DirectRPGBuilder::create(problem.getGoalConditions(), problem.getStateConstraints());
-	DirectCRPG heuristic(problem, DirectActionManager::create(actions), std::move(direct_builder));
+	if (name == "hmax") {
+		CachedHeuristic<DirectCHMax> heuristic(DirectCHMax(problem, DirectActionManager::create(actions), std::move(direct_builder)), config.getHeuristicCacheSize());
+		return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, CachedHeuristic<DirectCHMax>, GroundStateModel>(model, std::move(heuristic), delayed));
+	}
 	
-	return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, DirectCRPG, GroundStateModel>(model, std::move(heuristic), delayed));
+	CachedHeuristic<DirectCRPG> heuristic(DirectCRPG(problem, DirectActionManager::create(actions), std::move(direct_builder)), config.getHeuristicCacheSize());
+	return std::unique_ptr<FS0SearchAlgorithm>(new aptk::StlBestFirstSearch<SearchNode, CachedHeuristic<DirectCRPG>, GroundStateModel>(model, std::move(heuristic), delayed));
 }
 
 GroundStateModel
 NativeDriver::setup(const Config& config, Problem& problem) const {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
-	return GroundStateModel(problem);
+	ground_actions(problem);
+	return GroundStateModel(problem, config.useIncrementalApplicability());
 }
 
 bool
@@ -0,0 +1,70 @@
+
+#include <search/drivers/parallel_gbfs.hxx>
+#include <search/drivers/native_driver.hxx>
+#include <search/drivers/validation.hxx>
+#include <search/algorithms/parallel_gbfs.hxx>
+#include <search/algorithms/batch_parallel_gbfs.hxx>
+#include <problem.hxx>
+#include <state.hxx>
+#include <heuristics/relaxed_plan/gecode_crpg.hxx>
+#include <heuristics/relaxed_plan/direct_crpg.hxx>
+#include <constraints/direct/direct_rpg_builder.hxx>
+#include <constraints/direct/action_manager.hxx>
+#include <constraints/gecode/handlers/ground_action_csp.hxx>
+#include <utils/support.hxx>
+
+using namespace fs0::gecode;
+
+namespace fs0 { namespace drivers {
+
+std::unique_ptr<FS0SearchAlgorithm> ParallelGBFSDriver::create(const Config& config, const GroundStateModel& model) const {
+	const Problem& problem = model.getTask();
+	const std::vector<const GroundAction*>& actions = problem.getGroundActions();
+	
+	unsigned num_threads = config.getSearchThreads();
+	if (num_threads == 0) num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	
+	if (config.useDelayedEvaluation()) {
+		LPT_INFO("main", "The parallel GBFS drivers do not support delayed evaluation, which will be ignored");
+	}
+	
+	if (NativeDriver::check_supported(problem)) {
+		LPT_INFO("main", "Using the " << (_batch ? "batch-" : "") << "parallel GBFS driver with " << num_threads << " threads and the native RPG heuristic");
+		return create_engine<DirectCRPG>(model, num_threads, [&problem, &actions]() -> DirectCRPG* {
+			auto direct_builder = DirectRPGBuilder::create(problem.getGoalConditions(), problem.getStateConstraints());
+			return new DirectCRPG(problem, DirectActionManager::create(actions), std::move(direct_builder));
+		});
+	}
+	
+	LPT_INFO("main", "Using the " << (_batch ? "batch-" : "") << "parallel GBFS driver with " << num_threads << " threads and the Gecode RPG heuristic");
+	Validation::check_no_conditional_effects(problem);
+	
+	bool novelty = config.useNoveltyConstraint();
+	bool approximate = config.useApproximateActionResolution();
+	const auto managed = support::compute_managed_symbols(std::vector<const ActionBase*>(actions.begin(), actions.end()), problem.getGoalConditions(), problem.getStateConstraints());
+	
+	if (config.getHeuristic() == "hff") {
+		return create_engine<GecodeCRPG>(model, num_threads, [&]() -> GecodeCRPG* {
+			auto managers = GroundActionCSP::create(actions, problem.get_tuple_index(), approximate, novelty);
+			return new GecodeCRPG(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), ExtensionHandler(problem.get_tuple_index(), managed));
+		});
+	} else {
+		if (config.getHeuristic() != "hmax") throw std::runtime_error("Heuristic \"" + config.getHeuristic() + "\" is only supported by the native driver on STRIPS-like problems");
+		return create_engine<GecodeCHMax>(model, num_threads, [&]() -> GecodeCHMax* {
+			auto managers = GroundActionCSP::create(actions, problem.get_tuple_index(), approximate, novelty);
+			return new GecodeCHMax(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), ExtensionHandler(problem.get_tuple_index(), managed));
+		});
+	}
+}
+
+template <typename HeuristicT>
+std::unique_ptr<FS0SearchAlgorithm> ParallelGBFSDriver::create_engine(const GroundStateModel& model, unsigned num_threads, const std::function<HeuristicT*()>& factory) const {
+	// The heuristics are created sequentially, as the creation of the CSP handlers is not thread-safe
+	std::vector<std::unique_ptr<HeuristicT>> heuristics;
+	for (unsigned i = 0; i < num_threads; ++i) heuristics.push_back(std::unique_ptr<HeuristicT>(factory()));
+	
+	if (_batch) return std::unique_ptr<FS0SearchAlgorithm>(new BatchParallelGBFS<HeuristicT>(model, std::move(heuristics)));
+	return std::unique_ptr<FS0SearchAlgorithm>(new ParallelGBFS<HeuristicT>(model, std::move(heuristics)));
+}
+
+} } // namespaces
@@ -0,0 +1,32 @@
+
+#pragma once
+
+#include <functional>
+
+#include <search/drivers/registry.hxx>
+#include <utils/config.hxx>
+
+namespace fs0 { class GroundStateModel;}
+
+namespace fs0 { namespace drivers {
+
+//! An engine creator for multi-threaded Greedy Best-First Search drivers coupled with our constrained RPG-based heuristics:
+//! either a hash-distributed search, or a standard search where the successors of each node are evaluated in parallel.
+//! The native (DirectCRPG) heuristic is used whenever the problem is supported by the native CSP handlers, and the
+//! Gecode-based ones (constrained h_FF or h_max) otherwise. Each worker thread has its own heuristic instance.
+class ParallelGBFSDriver : public Driver {
+public:
+	//! If 'batch' is true, the driver creates a BatchParallelGBFS engine; otherwise, a (hash-distributed) ParallelGBFS engine
+	ParallelGBFSDriver(bool batch) : _batch(batch) {}
+	
+	std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& model) const;
+
+protected:
+	const bool _batch;
+	
+	//! Creates the parallel search engine with the given number of threads, using the factory to create the heuristic of each thread
+	template <typename HeuristicT>
+	std::unique_ptr<FS0SearchAlgorithm> create_engine(const GroundStateModel& model, unsigned num_threads, const std::function<HeuristicT*()>& factory) const;
+};
+
+} } // namespaces
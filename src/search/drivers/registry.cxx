@@ -9,6 +9,7 @@
 #include <search/drivers/unreached_atom_driver.hxx>
 #include <search/drivers/smart_effect_driver.hxx>
 #include <search/drivers/native_driver.hxx>
+#include <search/drivers/parallel_gbfs.hxx>
 // #include <heuristics/relaxed_plan/direct_crpg.hxx>
 // #include <heuristics/relaxed_plan/gecode_crpg.hxx>
 #include <actions/ground_action_iterator.hxx>
@@ -20,10 +21,14 @@
 namespace fs0 { namespace drivers {
 
 GroundStateModel Driver::setup(const Config& config, Problem& problem) const {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
-	return GroundStateModel(problem); // By default we ground all actions and return a model with the problem as it is
+	ground_actions(problem);
+	return GroundStateModel(problem, config.useIncrementalApplicability()); // By default we ground all actions and return a model with the problem as it is
 }
 
+void Driver::ground_actions(Problem& problem) {
+	if (problem.hasGroundActions()) return;
+	problem.setGroundActions(ActionGrounder::fully_ground(problem, ProblemInfo::getInstance()));
+}
 
 EngineRegistry& EngineRegistry::instance() {
 	static EngineRegistry theInstance;
@@ -38,6 +43,8 @@ EngineRegistry::EngineRegistry() {
 	add("lite",  new NativeDriver());
 	add("unreached_atom",  new UnreachedAtomDriver());
 	add("smart",  new SmartEffectDriver());
+	add("parallel_gbfs",  new ParallelGBFSDriver(false));
+	add("batch_gbfs",  new ParallelGBFSDriver(true));
 	
 	add("iw",  new IteratedWidthDriver());
 	add("novelty_best_first",  new GBFSNoveltyDriver());
@@ -24,6 +24,11 @@ public:
 	virtual std::unique_ptr<FS0SearchAlgorithm> create(const Config& config, const GroundStateModel& model) const = 0;
 	
 	virtual GroundStateModel setup(const Config& config, Problem& problem) const;
+
+protected:
+	//! Grounds the actions of the problem, unless they have already been grounded, e.g. by the setup of another driver
+	//! that runs on the same problem as part of a portfolio
+	static void ground_actions(Problem& problem);
 };
 
 
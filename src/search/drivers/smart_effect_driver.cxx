@@ -37,9 +37,9 @@ SmartEffectDriver::create(const Config& config, const GroundStateModel& model) c
 GroundStateModel
 SmartEffectDriver::setup(const Config& config, Problem& problem) const {
 	// We'll use all the ground actions for the search plus the partyally ground actions for the heuristic computations
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	ground_actions(problem);
 	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
-	return GroundStateModel(problem);
+	return GroundStateModel(problem, config.useIncrementalApplicability());
 }
 
 
@@ -37,8 +37,8 @@ std::unique_ptr<FS0SearchAlgorithm> UnreachedAtomDriver::create(const Config& co
 
 GroundStateModel UnreachedAtomDriver::setup(const Config& config, Problem& problem) const {
 	// We ground all actions
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
-	return GroundStateModel(problem);
+	ground_actions(problem);
+	return GroundStateModel(problem, config.useIncrementalApplicability());
 }
 
 } } // namespaces
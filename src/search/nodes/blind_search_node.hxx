@@ -27,13 +27,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <aptk2/tools/logging.hxx>
 #include <actions/actions.hxx>
+#include <state_registry.hxx>
 
 namespace fs0 { namespace drivers {
 
 template <typename State>
 class BlindSearchNode {
 public:
-	State state; // TODO - Check no extra copies are being performed, or switch to pointers otherwise.
+	//! The (interned) state of the node, owned by the state registry of the thread that created the node
+	StateRef state;
 	fs0::GroundAction::IdType action;
 	std::shared_ptr<BlindSearchNode<State>> parent;
 
@@ -46,14 +48,14 @@ public:
 	BlindSearchNode& operator=(const BlindSearchNode& rhs) = delete;
 	BlindSearchNode& operator=(BlindSearchNode&& rhs) = delete;
 	
-	//! Constructor with full copying of the state (expensive)
+	//! Constructor with full copying of the state (expensive, unless the state was already registered)
 	BlindSearchNode( const State& s )
-		: state( s ), action( fs0::GroundAction::invalid_action_id ), parent( nullptr )
+		: state( StateRegistry::instance().intern(s) ), action( fs0::GroundAction::invalid_action_id ), parent( nullptr )
 	{}
 
 	//! Constructor with move of the state (cheaper)
 	BlindSearchNode( State&& _state, fs0::GroundAction::IdType _action, std::shared_ptr< BlindSearchNode<State> > _parent ) :
-		state(std::move(_state)) {
+		state(StateRegistry::instance().intern(std::move(_state))) {
 		action = _action;
 		parent = _parent;
 	}
@@ -67,6 +69,7 @@ public:
 		return os;
 	}
 
+	//! Since states are interned, two nodes refer to the same state iff they have the same registry index.
 	bool operator==( const BlindSearchNode<State>& o ) const { return state == o.state; }
 
 	std::size_t hash() const { return state.hash(); }
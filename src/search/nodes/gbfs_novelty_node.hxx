@@ -27,6 +27,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <aptk2/tools/logging.hxx>
 #include <actions/actions.hxx>
+#include <state_registry.hxx>
 
 namespace fs0 { namespace drivers {
 
@@ -34,7 +35,8 @@ namespace fs0 { namespace drivers {
 template <typename State>
 class GBFSNoveltyNode {
 public:
-	State state;
+	//! The (interned) state of the node, owned by the state registry of the thread that created the node
+	StateRef state;
 	GroundAction::IdType action;
 	
 	std::shared_ptr<GBFSNoveltyNode<State> > parent;
@@ -57,14 +59,14 @@ public:
 	GBFSNoveltyNode& operator=(const GBFSNoveltyNode& rhs) = delete;
 	GBFSNoveltyNode& operator=(GBFSNoveltyNode&& rhs) = delete;
 	
-	//! Constructor with full copying of the state (expensive)
+	//! Constructor with full copying of the state (expensive, unless the state was already registered)
 	GBFSNoveltyNode(const State& s)
-		: state(s), action(GroundAction::invalid_action_id), parent(nullptr), g(0), novelty(0), num_unsat(0)
+		: state(StateRegistry::instance().intern(s)), action(GroundAction::invalid_action_id), parent(nullptr), g(0), novelty(0), num_unsat(0)
 	{}
 
 	//! Constructor with move of the state (cheaper)
 	GBFSNoveltyNode(State&& _state, GroundAction::IdType _action, std::shared_ptr< GBFSNoveltyNode<State> > _parent) :
-		state(std::move(_state)), action(_action), parent(_parent), g(_parent->g + 1), novelty(0), num_unsat(0)
+		state(StateRegistry::instance().intern(std::move(_state))), action(_action), parent(_parent), g(_parent->g + 1), novelty(0), num_unsat(0)
 	{}
 
 	bool has_parent() const { return parent != nullptr; }
@@ -77,13 +79,14 @@ public:
 		return os;
 	}
 
+	//! Since states are interned, two nodes refer to the same state iff they have the same registry index.
 	bool operator==( const GBFSNoveltyNode<State>& o ) const { return state == o.state; }
 
 	template <typename Heuristic>
 	void evaluate_with( Heuristic& heuristic ) {
-		novelty = heuristic.novelty( state );
+		novelty = heuristic.novelty(state.get());
 		if (novelty > heuristic.novelty_bound()) novelty = std::numeric_limits<unsigned>::infinity();
-		num_unsat = heuristic.evaluate_num_unsat_goals( state );
+		num_unsat = heuristic.evaluate_num_unsat_goals(state.get());
 	}
 	
 	void inherit_heuristic_estimate() {
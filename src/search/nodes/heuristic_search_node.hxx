@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <aptk2/tools/logging.hxx>
+#include <state_registry.hxx>
 
 namespace fs0 { namespace drivers {
 
@@ -42,11 +43,11 @@ public:
 	
 	
 	HeuristicSearchNode(const StateT& state_)
-		: state(state_), action(ActionT::invalid_action_id), parent(nullptr), g(0), h(0)
+		: state(StateRegistry::instance().intern(state_)), action(ActionT::invalid_action_id), parent(nullptr), g(0), h(0)
 	{}
 
 	HeuristicSearchNode(StateT&& state_, typename ActionT::IdType action_, std::shared_ptr<HeuristicSearchNode<StateT ,ActionT>> parent_) :
-		state(std::move(state_)), action(action_), parent(parent_), g(parent_->g + 1), h(0)
+		state(StateRegistry::instance().intern(std::move(state_))), action(action_), parent(parent_), g(parent_->g + 1), h(0)
 	{}
 
 	bool has_parent() const { return parent != nullptr; }
@@ -59,13 +60,14 @@ public:
 	}
 	
 	//! Forward the comparison and hash function to the search state.
+	//! Since states are interned, two nodes refer to the same state iff they have the same registry index.
 	bool operator==(const HeuristicSearchNode<StateT, ActionT>& o) const { return state == o.state; }
 	std::size_t hash() const { return state.hash(); }
 
 	// MRJ: This is part of the required interface of the Heuristic
 	template <typename Heuristic>
 	void evaluate_with(Heuristic& heuristic) {
-		h = heuristic.evaluate(state);
+		h = heuristic.evaluate(state.get());
 		LPT_DEBUG("heuristic" , std::endl << "Computed heuristic value of " << h <<  " for seed state: " << std::endl << state << std::endl << "****************************************");
 	}
 	
@@ -78,7 +80,8 @@ public:
 
 	bool dead_end() const { return h == -1; }
 
-	StateT state;
+	//! The (interned) state of the node, owned by the state registry of the thread that created the node
+	StateRef state;
 	
 	typename ActionT::IdType action;
 	
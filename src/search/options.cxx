@@ -24,6 +24,7 @@ EngineOptions::EngineOptions(int argc, char** argv) {
 		("driver,d", po::value<std::string>()->required(),                        "The desired driver.")
 		("defaults", po::value<std::string>()->default_value("./defaults.json"),  "The planner configuration file.")
 		("options", po::value<std::string>()->default_value(""),                  "Additional configuration options.")
+		("plugin", po::value<std::string>()->default_value(""),                   "The shared object with the instance-specific components, if the problem has any.")
 		("out", po::value<std::string>()->default_value("."),                     "The directory where the results data is to be output.");
 
 	po::variables_map vm;
@@ -47,6 +48,7 @@ EngineOptions::EngineOptions(int argc, char** argv) {
 	_defaults = vm["defaults"].as<std::string>();
 	_output_dir = vm["out"].as<std::string>();
 	_driver = vm["driver"].as<std::string>();
+	_plugin = vm["plugin"].as<std::string>();
 	
 	// Populate the map of additional options
 	std::string options = vm["options"].as<std::string>();
@@ -22,6 +22,9 @@ public:
 	
 	const std::string& getDriver() const { return _driver; }
 	
+	//! The path of the shared object with the instance-specific components, or an empty string if there is none
+	const std::string& getPluginPath() const { return _plugin; }
+	
 	const std::unordered_map<std::string, std::string>& getUserOptions() const { return _user_options; }
 	
 protected:
@@ -35,6 +38,8 @@ protected:
 	
 	std::string _driver;
 	
+	std::string _plugin;
+	
 	std::unordered_map<std::string, std::string> _user_options;
 };
 
@@ -3,6 +3,7 @@
 
 #include <problem.hxx>
 #include <utils/loader.hxx>
+#include <utils/plugin.hxx>
 #include <search/search.hxx>
 
 #include <search/runner.hxx>
@@ -13,8 +14,15 @@
 namespace fs0 { namespace drivers {
 
 Runner::Runner(const EngineOptions& options, ProblemGeneratorType generator) 
-	: _options(options), _generator(generator), _start_time(aptk::time_used())
-{}
+	: _options(options), _generator(generator), _plugin(), _start_time(aptk::time_used())
+{
+	if (!_options.getPluginPath().empty()) {
+		_plugin = std::unique_ptr<ProblemPlugin>(new ProblemPlugin(_options.getPluginPath()));
+		_generator = _plugin->getGenerator();
+	}
+}
+
+Runner::~Runner() = default;
 
 int Runner::run() {
 	aptk::Logger::init(_options.getOutputDir() + "/logs");
@@ -1,10 +1,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include <search/options.hxx>
 #include <lib/rapidjson/document.h>
 
-namespace fs0 { class Problem; }
+namespace fs0 { class Problem; class ProblemPlugin; }
 
 namespace fs0 { namespace drivers {
 	
@@ -15,7 +17,9 @@ public:
 	typedef std::function<Problem* (const rapidjson::Document&, const std::string&)> ProblemGeneratorType;
 	
 	//! Set up the runner, loading the problem, the configuration, etc.
+	//! If the options specify a problem plugin, the problem is generated by the plugin instead of by the given generator.
 	Runner(const EngineOptions& options, ProblemGeneratorType generator);
+	~Runner();
 	
 	//! Run the search engine
 	int run();
@@ -27,6 +31,9 @@ protected:
 	//! The concrete instance generator
 	ProblemGeneratorType _generator;
 	
+	//! The plugin with the instance-specific components, if any
+	std::unique_ptr<ProblemPlugin> _plugin;
+	
 	//! The runner starting time
 	float _start_time;
 };
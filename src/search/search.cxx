@@ -1,6 +1,10 @@
 
 
 #include <time.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 #include <aptk2/tools/resources_control.hxx>
 
@@ -13,6 +17,10 @@
 #include <utils/printers/printers.hxx>
 #include <languages/fstrips/language.hxx>
 #include <state.hxx>
+#include <state_registry.hxx>
+#include <utils/config.hxx>
+#include <aptk2/tools/logging.hxx>
+#include <heuristics/cached_heuristic.hxx>
 
 
 namespace fs0 { namespace drivers {
@@ -22,36 +30,48 @@ template <typename StateModelT, typename SearchAlgorithmT>
 void SearchUtils::do_search(SearchAlgorithmT& engine, const StateModelT& model, const std::string& out_dir, float start_time) {
 	const Problem& problem = model.getTask();
 
-	std::cout << "Writing results to directory: " << out_dir << std::endl;
-	std::ofstream plan_out(out_dir + "/first.plan");
-	std::ofstream json_out( out_dir + "/results.json" );
-
 	std::vector<typename StateModelT::ActionType::IdType> plan;
 	float t0 = aptk::time_used();
 	double _t0 = (double) clock() / CLOCKS_PER_SEC;
 	
+	// Each search starts with an empty state registry, so that no states of previous searches are kept around
+	StateRegistry::instance().clear();
 	bool solved = engine.solve_model( plan );
 	
 	float search_time = aptk::time_used() - t0;
 	double _search_time = (double) clock() / CLOCKS_PER_SEC - _t0;
+	
+	bool valid = solved && Checker::check_correctness(problem, plan, problem.getInitialState());
+	report_results(plan, solved, valid, engine.generated, engine.expanded, search_time, _search_time, out_dir, start_time);
+}
+
+template <typename PlanT>
+void SearchUtils::report_results(const PlanT& plan, bool solved, bool valid, unsigned long generated, unsigned long expanded, float search_time, double _search_time, const std::string& out_dir, float start_time, const std::string& driver) {
 	float total_planning_time = aptk::time_used() - start_time;
 
-	bool valid = false;
+	std::cout << "Writing results to directory: " << out_dir << std::endl;
+	std::ofstream plan_out(out_dir + "/first.plan");
+	std::ofstream json_out( out_dir + "/results.json" );
 	
 	if ( solved ) {
 		PlanPrinter::print(plan, plan_out);
-		valid = Checker::check_correctness(problem, plan, problem.getInitialState());
 	}
 	plan_out.close();
 
-	std::string eval_speed = (search_time > 0) ? std::to_string((float) engine.generated / search_time) : "0";
+	std::string eval_speed = (search_time > 0) ? std::to_string((float) generated / search_time) : "0";
 	json_out << "{" << std::endl;
+	if (!driver.empty()) json_out << "\t\"driver\": \"" << driver << "\"," << std::endl;
 	json_out << "\t\"total_time\": " << total_planning_time << "," << std::endl;
 	json_out << "\t\"search_time\": " << search_time << "," << std::endl;
 	json_out << "\t\"search_time_alt\": " << _search_time << "," << std::endl;
-	json_out << "\t\"generated\": " << engine.generated << "," << std::endl;
-	json_out << "\t\"expanded\": " << engine.expanded << "," << std::endl;
+	json_out << "\t\"generated\": " << generated << "," << std::endl;
+	json_out << "\t\"expanded\": " << expanded << "," << std::endl;
 	json_out << "\t\"eval_per_second\": " << eval_speed << "," << std::endl;
+	const HeuristicCacheStats& cache = HeuristicCacheStats::instance();
+	if (cache.used()) {
+		json_out << "\t\"heuristic_cache_hits\": " << cache.hits() << "," << std::endl;
+		json_out << "\t\"heuristic_cache_misses\": " << cache.misses() << "," << std::endl;
+	}
 	json_out << "\t\"solved\": " << ( solved ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"valid\": " << ( valid ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"plan_length\": " << plan.size() << "," << std::endl;
@@ -63,8 +83,9 @@ void SearchUtils::do_search(SearchAlgorithmT& engine, const StateModelT& model,
 	
 	if (solved) {
 		if (!valid) throw std::runtime_error("The plan output by the planner is not correct!");
+		if (!driver.empty()) std::cout << "Plan found by driver: " << driver << std::endl;
 		std::cout << "Search Result: Found plan of length " << plan.size() << std::endl;
-		std::cout << "Expanded / Evaluated / Eval. rate: " << engine.expanded << " / " << engine.generated << " / " << eval_speed << std::endl;
+		std::cout << "Expanded / Evaluated / Eval. rate: " << expanded << " / " << generated << " / " << eval_speed << std::endl;
 	} else {
 		std::cout << "Search Result: No plan was found " << std::endl;
 		// TODO - Make distinction btw all nodes explored and no plan found, and no plan found in the given time.
@@ -74,6 +95,73 @@ void SearchUtils::do_search(SearchAlgorithmT& engine, const StateModelT& model,
 	std::cout << "Actual Search Time: " << search_time << " s." << std::endl;
 }
 
+void SearchUtils::run_portfolio(Problem& problem, const Config& config, const std::vector<std::string>& driver_tags, const std::string& out_dir, float start_time) {
+	if (driver_tags.empty()) throw std::runtime_error("The portfolio driver needs at least one driver, see the 'portfolio' configuration option");
+	LPT_INFO("main", "Running a portfolio of " << driver_tags.size() << " drivers");
+	
+	// All models and engines are set up sequentially, as grounding and heuristic construction are not thread-safe.
+	// The problem is grounded only once, by the first driver. All models share the flag that stops the search.
+	std::atomic<bool> stop(false);
+	std::vector<std::unique_ptr<GroundStateModel>> models;
+	std::vector<std::unique_ptr<FS0SearchAlgorithm>> engines;
+	for (const std::string& tag:driver_tags) {
+		if (tag == "portfolio") throw std::runtime_error("A portfolio cannot contain itself");
+		auto driver = EngineRegistry::instance().get(tag);
+		models.push_back(std::unique_ptr<GroundStateModel>(new GroundStateModel(driver->setup(config, problem))));
+		models.back()->set_stop_flag(&stop);
+		engines.push_back(driver->create(config, *models.back()));
+	}
+	
+	// Each engine then runs on its own thread. The first one to find a valid plan reports it and sets the stop flag,
+	// upon which the rest of engines are interrupted on their next expansion; if all of them fail, no plan exists (or none could be found).
+	std::mutex report_mutex;
+	float t0 = aptk::time_used();
+	double _t0 = (double) clock() / CLOCKS_PER_SEC;
+	std::vector<std::thread> threads;
+	std::vector<std::exception_ptr> errors(engines.size());
+	for (unsigned i = 0; i < engines.size(); ++i) {
+		threads.push_back(std::thread([&, i]() {
+			try {
+				FS0SearchAlgorithm& engine = *engines[i];
+				FS0SearchAlgorithm::Plan plan;
+				bool solved = engine.solve_model(plan);
+				
+				std::lock_guard<std::mutex> lock(report_mutex);
+				if (stop) return; // Some other engine already reported its plan
+				if (!solved) {
+					LPT_INFO("main", "Portfolio driver " << driver_tags[i] << " finished without finding a plan");
+					return;
+				}
+				if (!Checker::check_correctness(problem, plan, problem.getInitialState())) {
+					LPT_INFO("main", "Portfolio driver " << driver_tags[i] << " returned an invalid plan");
+					return;
+				}
+				report_results(plan, true, true, engine.generated, engine.expanded, aptk::time_used() - t0, (double) clock() / CLOCKS_PER_SEC - _t0, out_dir, start_time, driver_tags[i]);
+				stop = true;
+			} catch (const SearchInterrupted&) {
+				LPT_INFO("main", "Portfolio driver " << driver_tags[i] << " interrupted");
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		}));
+	}
+	for (std::thread& thread:threads) thread.join();
+	
+	for (unsigned i = 0; i < errors.size(); ++i) {
+		if (!errors[i]) continue;
+		try { std::rethrow_exception(errors[i]); }
+		catch (const std::exception& ex) { std::cout << "Portfolio driver " << driver_tags[i] << " failed: " << ex.what() << std::endl; }
+	}
+	if (stop) return;
+	
+	unsigned long generated = 0, expanded = 0;
+	for (const auto& engine:engines) {
+		generated += engine->generated;
+		expanded += engine->expanded;
+	}
+	report_results(FS0SearchAlgorithm::Plan(), false, false, generated, expanded, aptk::time_used() - t0, (double) clock() / CLOCKS_PER_SEC - _t0, out_dir, start_time, "portfolio");
+}
+
 void SearchUtils::instantiate_seach_engine_and_run(Problem& problem, const Config& config, const std::string& driver_tag, const std::string& out_dir, float start_time) {
 	std::cout << "Starting search..." << std::endl;
 	
@@ -92,6 +180,9 @@ void SearchUtils::instantiate_seach_engine_and_run(Problem& problem, const Confi
 		auto engine = driver.create(config, model);
 		do_search(*engine, model, out_dir, start_time);
 		
+	} else if (driver_tag == "portfolio") {
+		run_portfolio(problem, config, config.getPortfolio(), out_dir, start_time);
+		
 	} else {
 		// Standard, grounded planning
 		auto driver = fs0::drivers::EngineRegistry::instance().get(driver_tag);
@@ -110,10 +201,6 @@ void SearchUtils::report_stats(const Problem& problem) {
 	std::cout << "Number of action schemata: " << problem.getActionData().size() << std::endl;
 	std::cout << "Number of (perhaps partially) ground actions: " << n_actions << std::endl;
 	
-	if (n_actions > 1000) {
-		std::cout << "WARNING: The number of ground actions (" << n_actions << ") is too high for our applicable action strategy to perform well." << std::endl;
-	}
-
 	std::cout << "Number of state constraints: " << problem.getStateConstraints()->all_atoms().size() << std::endl;
 	std::cout << "Number of goal conditions: " << problem.getGoalConditions()->all_atoms().size() << std::endl;
 }
@@ -13,6 +13,15 @@ public:
 	template <typename StateModelT, typename SearchAlgorithmT>
 	static void do_search(SearchAlgorithmT& engine, const StateModelT& model, const std::string& out_dir, float start_time);
 
+	//! Writes the plan and the search statistics to the given output directory. If a driver tag is given, it is recorded too.
+	template <typename PlanT>
+	static void report_results(const PlanT& plan, bool solved, bool valid, unsigned long generated, unsigned long expanded, float search_time, double _search_time,
+							   const std::string& out_dir, float start_time, const std::string& driver = "");
+
+	//! Runs concurrently, on the same (already loaded) problem, the search engines of all the given drivers, and reports
+	//! the first valid plan found by any of them, upon which the rest of engines are interrupted.
+	static void run_portfolio(Problem& problem, const Config& config, const std::vector<std::string>& driver_tags, const std::string& out_dir, float start_time);
+
 	//! Instantiate 
 	static void instantiate_seach_engine_and_run(Problem& problem, const Config& config, const std::string& driver, const std::string& out_dir, float start_time);
 	
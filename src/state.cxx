@@ -1,6 +1,4 @@
 
-#include <boost/functional/hash.hpp>
-
 #include <state.hxx>
 #include <problem_info.hxx>
 #include <atom.hxx>
@@ -9,13 +7,20 @@
 namespace fs0 {
 
 State::State(unsigned numAtoms, const std::vector<Atom>& facts) :
-	_values(numAtoms)
+	_packed(layout().getNumBlocks(), 0)
 {
+	assert(numAtoms == layout().getNumVariables());
+	
 	// Note that those facts not explicitly set in the initial state will be initialized to 0, i.e. "false", which is convenient to us.
+	// Since the packing of a variable might encode values with some offset, we need to set the value explicitly.
+	for (VariableIdx variable = 0; variable < numAtoms; ++variable) {
+		layout().set(_packed.data(), variable, 0);
+	}
+	updateHash(); // From here on, the hash is updated incrementally with each change
+	
 	for (const auto& fact:facts) { // Insert all the elements of the vector
 		set(fact);
 	}
-	updateHash();
 }
 
 State::State(const State& state, const std::vector<Atom>& atoms) :
@@ -23,8 +28,16 @@ State::State(const State& state, const std::vector<Atom>& atoms) :
 	accumulate(atoms);
 }
 	
+const StateLayout& State::layout() { return ProblemInfo::getInstance().getStateLayout(); }
+
 void State::set(const Atom& atom) {
-	_values.at(atom.getVariable()) = atom.getValue();
+	const StateLayout& packing = layout();
+	VariableIdx variable = atom.getVariable();
+	assert(variable < packing.getNumVariables());
+	ObjectIdx old = packing.get(_packed.data(), variable);
+	if (old == atom.getValue()) return;
+	packing.set(_packed.data(), variable, atom.getValue());
+	_hash ^= packing.key(variable, old) ^ packing.key(variable, atom.getValue()); // XOR the old atom out and the new one in
 }
 
 bool State::contains(const Atom& atom) const {
@@ -32,36 +45,56 @@ bool State::contains(const Atom& atom) const {
 }
 
 ObjectIdx State::getValue(const VariableIdx& variable) const {
-	return _values.at(variable);
+	assert(variable < numAtoms());
+	return layout().get(_packed.data(), variable);
 }
 
-//! Applies the given changeset into the current state.
+std::vector<ObjectIdx> State::getValues() const {
+	const StateLayout& packing = layout();
+	std::vector<ObjectIdx> values;
+	values.reserve(packing.getNumVariables());
+	for (VariableIdx variable = 0; variable < packing.getNumVariables(); ++variable) {
+		values.push_back(packing.get(_packed.data(), variable));
+	}
+	return values;
+}
+
+unsigned State::numAtoms() const { return layout().getNumVariables(); }
+
+//! Applies the given changeset into the current state. The hash is updated incrementally by set(), in O(|atoms|).
 void State::accumulate(const std::vector<Atom>& atoms) {
 	for (const Atom& fact:atoms) { 
 		set(fact);
 	}
-	updateHash(); // Important to update the hash value after all the changes have been applied!
 }
 
 std::ostream& State::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "State";
 	os << "(" << _hash << ")[";
-	for (unsigned i = 0; i < _values.size(); ++i) {
+	for (unsigned i = 0; i < numAtoms(); ++i) {
+		ObjectIdx value = getValue(i);
 		if (info.getVariableGenericType(i) == ProblemInfo::ObjectType::BOOL) {
-			if (_values.at(i) == 0) continue;
+			if (value == 0) continue;
 			
 			// Print only those atoms which are true in the state
 			os << info.getVariableName(i);
 		} else {
-			os << info.getVariableName(i) << "=" << info.getObjectName(i, _values.at(i));
+			os << info.getVariableName(i) << "=" << info.getObjectName(i, value);
 		}
-		if (i < _values.size() - 1) os << ", ";
+		if (i < numAtoms() - 1) os << ", ";
 	}
 	os << "]";
 	return os;
 }
 
-std::size_t State::computeHash() const { return boost::hash_range(_values.begin(), _values.end()); }
+std::size_t State::computeHash() const {
+	const StateLayout& packing = layout();
+	std::size_t hash = 0;
+	for (VariableIdx variable = 0; variable < packing.getNumVariables(); ++variable) {
+		hash ^= packing.key(variable, packing.get(_packed.data(), variable));
+	}
+	return hash;
+}
 
 } // namespaces
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <fs_types.hxx>
+#include <state_layout.hxx>
 
 namespace fs0 {
 
@@ -10,8 +11,8 @@ class Atom;
 
 class State {
 protected:
-	//! A vector mapping state variable (implicit) ids to their value in the current state.
-	std::vector<ObjectIdx> _values;
+	//! The values of all state variables, bit-packed according to the (global) state layout.
+	std::vector<StateLayout::BlockT> _packed;
 
 	std::size_t _hash;
 
@@ -38,25 +39,31 @@ public:
 	State& operator=(State&& state) = default;
 
 	// Check the hash first for performance.
-	bool operator==(const State &rhs) const { return _hash == rhs._hash && _values == rhs._values; }
+	bool operator==(const State &rhs) const { return _hash == rhs._hash && _packed == rhs._packed; }
 	bool operator!=(const State &rhs) const { return !(this->operator==(rhs));}
 	
+	//! Sets the given atom, updating the (Zobrist) hash of the state incrementally
 	void set(const Atom& atom);
 	
 	bool contains(const Atom& atom) const;
 	
 	ObjectIdx getValue(const VariableIdx& variable) const;
 	
-	const std::vector<ObjectIdx>& getValues() const { return _values; }
+	//! Returns an unpacked copy of the values of all state variables
+	std::vector<ObjectIdx> getValues() const;
 
-	unsigned numAtoms() const { return _values.size(); }
+	unsigned numAtoms() const;
 	
 	//! "Applies" the given atoms into the current state.
 	void accumulate(const std::vector<Atom>& atoms);
 
 protected:
+	//! The layout according to which state values are packed
+	static const StateLayout& layout();
+	
 	void updateHash() { _hash = computeHash(); }
 	
+	//! Computes from scratch the hash of the state, i.e. the XOR of the Zobrist keys of all its atoms
 	std::size_t computeHash() const;
 	
 public:
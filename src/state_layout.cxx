@@ -0,0 +1,110 @@
+
+#include <random>
+
+#include <state_layout.hxx>
+#include <problem_info.hxx>
+
+namespace fs0 {
+
+const std::size_t StateLayout::NO_KEYS = std::numeric_limits<std::size_t>::max();
+
+StateLayout::StateLayout(const ProblemInfo& info) :
+	_slots(info.getNumVariables()),
+	_num_blocks(0)
+{
+	std::vector<VariableIdx> multibit;
+	unsigned block = 0, offset = 0;
+
+	// Predicative variables go first, one bit each, so that they end up packed as a contiguous bitset
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		auto range = compute_range(info, variable);
+		Slot& slot = _slots[variable];
+		slot.min = range.first;
+		slot.max = range.second;
+		slot.range = static_cast<BlockT>(range.second - range.first);
+		slot.width = compute_width(static_cast<uint64_t>(range.second - range.first) + 1);
+		slot.mask = (slot.width == BLOCK_BITS) ? ~BlockT(0) : ((BlockT(1) << slot.width) - 1);
+		
+		// Every value of the domain of the variable must be encodable in its slot
+		if (range.first > range.second || static_cast<uint64_t>(range.second - range.first) > slot.mask) {
+			throw std::runtime_error("The domain of state variable " + std::to_string(variable) + " cannot be packed into " + std::to_string(slot.width) + " bits");
+		}
+
+		if (slot.width != 1) {
+			multibit.push_back(variable);
+			continue;
+		}
+
+		if (offset == BLOCK_BITS) { ++block; offset = 0; }
+		slot.block = block;
+		slot.shift = offset++;
+	}
+
+	// The rest of variables are laid out in order, making sure that no slot spans two different blocks
+	for (VariableIdx variable:multibit) {
+		Slot& slot = _slots[variable];
+		if (offset + slot.width > BLOCK_BITS) { ++block; offset = 0; }
+		slot.block = block;
+		slot.shift = offset;
+		offset += slot.width;
+	}
+
+	_num_blocks = (offset == 0) ? block : block + 1;
+	
+	generate_keys();
+}
+
+void StateLayout::out_of_range(VariableIdx variable, ObjectIdx value) {
+	throw std::runtime_error("Value " + std::to_string(value) + " is out of the domain of state variable " + std::to_string(variable));
+}
+
+void StateLayout::generate_keys() {
+	std::mt19937_64 generator(1); // A fixed seed, so that state hashes are reproducible across runs
+	for (Slot& slot:_slots) {
+		uint64_t num_values = static_cast<uint64_t>(slot.max - slot.min) + 1;
+		if (num_values > MAX_KEYS_PER_VARIABLE) {
+			slot.keys = NO_KEYS;
+			continue;
+		}
+		slot.keys = _keys.size();
+		for (uint64_t i = 0; i < num_values; ++i) _keys.push_back(static_cast<std::size_t>(generator()));
+	}
+}
+
+std::pair<int64_t, int64_t> StateLayout::compute_range(const ProblemInfo& info, VariableIdx variable) {
+	if (info.isPredicativeVariable(variable) || info.getVariableGenericType(variable) == ProblemInfo::ObjectType::BOOL) {
+		return std::make_pair(0, 1);
+	}
+
+	int64_t min = 0, max = 0; // The range always includes 0, as that is the value of any variable not explicitly set
+	if (info.isBoundedVariable(variable)) {
+		const auto& bounds = info.getVariableBounds(variable);
+		min = std::min<int64_t>(min, bounds.first);
+		max = std::max<int64_t>(max, bounds.second);
+	} else {
+		const ObjectIdxVector& objects = info.getVariableObjects(variable);
+		if (objects.empty()) { // We know nothing about the possible values of the variable, so we reserve a full integer for it
+			return std::make_pair(std::numeric_limits<ObjectIdx>::min(), std::numeric_limits<ObjectIdx>::max());
+		}
+		for (ObjectIdx object:objects) {
+			min = std::min<int64_t>(min, object);
+			max = std::max<int64_t>(max, object);
+		}
+	}
+	return std::make_pair(min, max);
+}
+
+unsigned StateLayout::compute_width(uint64_t num_values) {
+	unsigned width = 1;
+	while (width < BLOCK_BITS && (uint64_t(1) << width) < num_values) ++width;
+	return width;
+}
+
+std::ostream& StateLayout::print(std::ostream& os) const {
+	unsigned bits = 0;
+	for (const Slot& slot:_slots) bits += slot.width;
+	os << "StateLayout[" << _slots.size() << " variables, " << bits << " bits, " << _num_blocks << " blocks of " << BLOCK_BITS << " bits, " << _keys.size() << " hash keys]";
+	return os;
+}
+
+} // namespaces
@@ -0,0 +1,110 @@
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+#include <fs_types.hxx>
+
+namespace fs0 {
+
+class ProblemInfo;
+
+//! The physical layout of a packed state. Every state variable is assigned a slot of a fixed number of bits
+//! within a vector of blocks: predicative variables take a single bit each and are laid out contiguously
+//! at the beginning of the vector, while the remaining variables take only as many bits as needed to encode
+//! the range of values of their type. The layout is computed only once from the problem info.
+//! The layout also holds the (Zobrist) random keys used to hash states incrementally: the hash of a state
+//! is the XOR of the keys of all its atoms, hence updating an atom takes only two XOR operations.
+class StateLayout {
+public:
+	//! The type of the blocks where the state values are packed
+	typedef uint64_t BlockT;
+	static const unsigned BLOCK_BITS = 64;
+
+	StateLayout(const ProblemInfo& info);
+	~StateLayout() = default;
+
+	StateLayout(const StateLayout&) = delete;
+	StateLayout& operator=(const StateLayout&) = delete;
+
+	//! The number of state variables and number of blocks needed to store a full state
+	unsigned getNumVariables() const { return _slots.size(); }
+	unsigned getNumBlocks() const { return _num_blocks; }
+
+	//! Returns the value of the given variable as encoded in the given blocks
+	inline ObjectIdx get(const BlockT* blocks, VariableIdx variable) const {
+		const Slot& slot = _slots[variable];
+		return static_cast<ObjectIdx>(static_cast<int64_t>((blocks[slot.block] >> slot.shift) & slot.mask) + slot.min);
+	}
+
+	//! Encodes the given value of the given variable into the given blocks. Throws if the value lies outside the domain of
+	//! the variable, e.g. because of an effect without bound checks, instead of overwriting the slots of other variables.
+	inline void set(BlockT* blocks, VariableIdx variable, ObjectIdx value) const {
+		const Slot& slot = _slots[variable];
+		BlockT encoded = static_cast<BlockT>(static_cast<int64_t>(value) - slot.min);
+		if (encoded > slot.range) out_of_range(variable, value); // Values below the minimum wrap around to large offsets
+		BlockT& block = blocks[slot.block];
+		block = (block & ~(slot.mask << slot.shift)) | (encoded << slot.shift);
+	}
+
+	//! The number of bits taken by the given variable
+	unsigned getWidth(VariableIdx variable) const { return _slots.at(variable).width; }
+
+	//! Returns the Zobrist key of the atom <variable, value>
+	inline std::size_t key(VariableIdx variable, ObjectIdx value) const {
+		const Slot& slot = _slots[variable];
+		if (slot.keys == NO_KEYS) return mix(variable, value);
+		return _keys[slot.keys + static_cast<std::size_t>(static_cast<int64_t>(value) - slot.min)];
+	}
+
+	//! Prints a representation of the object to the given stream.
+	friend std::ostream& operator<<(std::ostream &os, const StateLayout& o) { return o.print(os); }
+	std::ostream& print(std::ostream& os) const;
+
+protected:
+	//! The position of a single state variable within the packed blocks
+	struct Slot {
+		unsigned block;
+		unsigned shift;
+		unsigned width;
+		BlockT mask;
+		int64_t min;
+		int64_t max;
+		BlockT range; // max - min
+		std::size_t keys; // The offset of the variable keys within the key table
+	};
+
+	std::vector<Slot> _slots;
+
+	unsigned _num_blocks;
+
+	//! The Zobrist key table, with one random key per possible atom. Variables with a range too large to
+	//! afford one key per value get no keys, and their atoms are hashed by mixing the variable and value.
+	std::vector<std::size_t> _keys;
+	static const std::size_t NO_KEYS;
+	static const uint64_t MAX_KEYS_PER_VARIABLE = 1 << 16;
+
+	//! Builds the Zobrist key table
+	void generate_keys();
+
+	//! A (splitmix64) mixing function to hash the atoms of variables without keys
+	static std::size_t mix(VariableIdx variable, ObjectIdx value) {
+		uint64_t z = (static_cast<uint64_t>(variable) << 32) + static_cast<uint32_t>(value) + 0x9E3779B97F4A7C15ULL;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return static_cast<std::size_t>(z ^ (z >> 31));
+	}
+
+	//! Throws the error of an attempt to set a value outside the domain of a variable
+	[[noreturn]] static void out_of_range(VariableIdx variable, ObjectIdx value);
+
+	//! Computes the range of values that we need to be able to encode for the given variable
+	static std::pair<int64_t, int64_t> compute_range(const ProblemInfo& info, VariableIdx variable);
+
+	//! Returns the number of bits necessary to encode 'num_values' different values
+	static unsigned compute_width(uint64_t num_values);
+};
+
+} // namespaces
@@ -0,0 +1,55 @@
+
+#include <state_registry.hxx>
+
+namespace fs0 {
+
+StateRegistry& StateRegistry::instance() {
+	// Each thread has its own registry, so that several searches can run concurrently, e.g. in a portfolio
+	static thread_local StateRegistry theInstance;
+	return theInstance;
+}
+
+StateRegistry::StateRegistry() :
+	_states(),
+	_index(0, IndexHash{*this}, IndexEqual{*this}),
+	_probe(nullptr),
+	_last_unique(false),
+	_generation(0)
+{}
+
+StateIdx StateRegistry::find(const State& state) const {
+	_probe = &state;
+	auto it = _index.find(INVALID_STATE);
+	_probe = nullptr;
+	return (it == _index.end()) ? INVALID_STATE : *it;
+}
+
+StateIdx StateRegistry::intern(State&& state) {
+	// We tentatively register the state, and roll back the registration if an equal state was already there.
+	StateIdx idx = _states.size();
+	_states.push_back(std::move(state));
+	auto res = _index.insert(idx);
+	if (!res.second) _states.pop_back();
+	
+	if (res.second) _last_unique = true;
+	else if (*res.first == _states.size() - 1) _last_unique = false;
+	return *res.first;
+}
+
+bool StateRegistry::release(StateIdx idx) {
+	if (!_last_unique || idx != _states.size() - 1) return false;
+	_index.erase(idx);
+	_states.pop_back();
+	_last_unique = false; // The state now registered last might have been interned any number of times
+	return true;
+}
+
+void StateRegistry::clear() {
+	_index.clear();
+	_states.clear();
+	_states.shrink_to_fit();
+	_last_unique = false;
+	++_generation;
+}
+
+} // namespaces
@@ -0,0 +1,127 @@
+
+#pragma once
+
+#include <cassert>
+#include <deque>
+#include <unordered_set>
+
+#include <state.hxx>
+
+namespace fs0 {
+
+//! The index identifying a state interned in the state registry
+typedef unsigned StateIdx;
+const StateIdx INVALID_STATE = std::numeric_limits<unsigned>::max();
+
+//! A (per-thread singleton) registry that interns all the states seen during the search, so that each distinct state
+//! is stored exactly once and can be identified by a 32-bit index. Registered states are never moved, hence
+//! references to them remain valid until the registry is cleared. Every thread has its own registry; registered states
+//! can be read, but not registered, from other threads, provided that they are accessed through a reference
+//! obtained in the owning thread. The registry is meant to be cleared by the search engines whenever a search
+//! (or an iteration of a search, as in IW) ends and its nodes have been released, and the state of a node pruned
+//! right after its generation can be released on its own (see 'release').
+class StateRegistry {
+public:
+	~StateRegistry() = default;
+	StateRegistry(const StateRegistry&) = delete;
+	StateRegistry& operator=(const StateRegistry&) = delete;
+
+	//! The singleton accessor, which returns the registry of the calling thread
+	static StateRegistry& instance();
+
+	//! Returns the index of the given state, registering it first if no equal state had been registered before.
+	StateIdx intern(State&& state);
+	StateIdx intern(const State& state) { return intern(State(state)); }
+
+	//! Returns the registered state with the given index
+	const State& get(StateIdx idx) const { assert(idx < _states.size()); return _states[idx]; }
+	
+	//! Returns the index of the registered state equal to the given state, or INVALID_STATE if there is none
+	StateIdx find(const State& state) const;
+
+	//! A small helper to intern a state and retrieve its registered (canonical) version
+	const State& canonical(State&& state) { return get(intern(std::move(state))); }
+	const State& canonical(const State& state) { return get(intern(state)); }
+
+	//! The number of distinct registered states
+	unsigned size() const { return _states.size(); }
+	
+	//! Unregisters the given state iff it is the most recently registered state and it has been interned only once,
+	//! i.e. iff whoever registered it holds the only index to it, and returns whether it was unregistered. This lets
+	//! a search discard the state of a successor that it prunes before generating any other successor.
+	bool release(StateIdx idx);
+
+	//! Removes all registered states, invalidating all indexes and references to them
+	void clear();
+	
+	//! The number of times that the registry has been cleared, which lets clients tell whether the indexes they hold are still valid
+	unsigned generation() const { return _generation; }
+
+protected:
+	StateRegistry();
+
+	//! Hash and equality functors that resolve state indexes against the registered states.
+	//! The INVALID_STATE index stands for the (unregistered) state being looked up by 'find'.
+	struct IndexHash {
+		const StateRegistry& registry;
+		std::size_t operator()(StateIdx idx) const { return registry.resolve(idx).hash(); }
+	};
+
+	struct IndexEqual {
+		const StateRegistry& registry;
+		bool operator()(StateIdx i1, StateIdx i2) const { return registry.resolve(i1) == registry.resolve(i2); }
+	};
+	
+	const State& resolve(StateIdx idx) const { return (idx == INVALID_STATE) ? *_probe : _states[idx]; }
+
+	//! The registered states, in order of registration. A deque guarantees that references are not invalidated by insertions.
+	std::deque<State> _states;
+
+	//! The set of indexes of registered states, hashed and compared through the states themselves
+	std::unordered_set<StateIdx, IndexHash, IndexEqual> _index;
+	
+	//! The state being looked up by 'find'
+	mutable const State* _probe;
+	
+	//! Whether the most recently registered state has been interned only once since it was registered
+	bool _last_unique;
+	
+	unsigned _generation;
+};
+
+//! A reference to a state registered in the registry of the current thread, which takes only the 32 bits of its index.
+//! Two references denote the same state iff they have the same index. In debug builds, the reference also records its
+//! registry and the generation of the registry, and checks that it is resolved against the same registry and that the
+//! registry has not been cleared since.
+class StateRef {
+public:
+	explicit StateRef(StateIdx idx) : _idx(idx)
+#ifndef NDEBUG
+		, _registry(&StateRegistry::instance()), _generation(_registry->generation())
+#endif
+	{}
+
+	StateIdx index() const { return _idx; }
+
+	const State& get() const {
+		assert(_registry == &StateRegistry::instance() && _generation == _registry->generation());
+		return StateRegistry::instance().get(_idx);
+	}
+	operator const State&() const { return get(); }
+
+	std::size_t hash() const { return get().hash(); }
+
+	bool operator==(const StateRef& other) const { return _idx == other._idx; }
+	bool operator!=(const StateRef& other) const { return _idx != other._idx; }
+
+	friend std::ostream& operator<<(std::ostream &os, const StateRef& ref) { return os << ref.get(); }
+
+protected:
+	StateIdx _idx;
+#ifndef NDEBUG
+	const StateRegistry* _registry;
+	unsigned _generation;
+#endif
+};
+
+} // namespaces
@@ -47,4 +47,6 @@ const binding_iterator binding_iterator::operator++(int) {binding_iterator tmp(*
 
 bool binding_iterator::ended() const { return _iterator->ended(); }
 
+void binding_iterator::seek(unsigned index) { _iterator->seek(index); }
+
 } } // namespaces
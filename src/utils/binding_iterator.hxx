@@ -42,6 +42,9 @@ public:
 	const binding_iterator operator++(int);
 	
 	bool ended() const;
+	
+	//! Positions the iterator at the binding with the given index, in the order of iteration
+	void seek(unsigned index);
 };
 
 
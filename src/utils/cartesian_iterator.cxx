@@ -48,6 +48,22 @@ void cartesian_iterator::advanceIterator(unsigned idx) {
 	}
 }
 
+void cartesian_iterator::seek(unsigned index) {
+	if (_iterators.size() != _values.size()) return; // Some set is empty, hence so is the product
+	if (index >= size()) {
+		_ended = true;
+		return;
+	}
+	// The index is decomposed in mixed radix, with the last set as the least significant digit
+	_ended = _values.empty();
+	for (int idx = _values.size() - 1; idx >= 0; --idx) {
+		unsigned size = _values[idx]->size();
+		_iterators[idx] = _values[idx]->begin() + (index % size);
+		updateElement(idx);
+		index /= size;
+	}
+}
+
 void cartesian_iterator::updateElement(unsigned idx) {
 	assert(_iterators[idx] != _values[idx]->end());
 	_element[idx] = *(_iterators[idx]);
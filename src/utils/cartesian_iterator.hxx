@@ -32,6 +32,10 @@ public:
 	void advanceIterator(unsigned idx);
 	
 	void updateElement(unsigned idx);
+	
+	//! Positions the iterator at the element with the given index in the order of iteration, i.e. skips 'index' elements
+	//! from the beginning, in time linear in the number of sets of the product
+	void seek(unsigned index);
 
 	const std::vector<ObjectIdx>& operator*() const { return _element; }
 	
@@ -2,6 +2,9 @@
 #include <utils/config.hxx>
 #include <fs_types.hxx>
 #include <boost/property_tree/json_parser.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
 
 
 namespace pt = boost::property_tree;
@@ -41,6 +44,34 @@ OptionType parseOption(const pt::ptree& tree, const std::unordered_map<std::stri
 	return it2->second;
 }
 
+//! Parses a numeric option, with the same precedence rules as above
+template <typename OptionType>
+OptionType parseNumericOption(const pt::ptree& tree, const std::unordered_map<std::string, std::string>& user_options, const std::string& key) {
+	auto it = user_options.find(key);
+	std::string parsed = (it != user_options.end()) ? it->second : tree.get<std::string>(key);
+	try {
+		return boost::lexical_cast<OptionType>(parsed);
+	} catch (const boost::bad_lexical_cast& e) {
+		throw std::runtime_error("Invalid configuration option for key " + key + ": " + parsed);
+	}
+}
+
+//! Parses an option that can take any string value, with the same precedence rules as above
+std::string parseStringOption(const pt::ptree& tree, const std::unordered_map<std::string, std::string>& user_options, const std::string& key) {
+	auto it = user_options.find(key);
+	return (it != user_options.end()) ? it->second : tree.get<std::string>(key);
+}
+
+//! Parses a list option, whose values are separated by colons (commas separate the different user options)
+std::vector<std::string> parseListOption(const pt::ptree& tree, const std::unordered_map<std::string, std::string>& user_options, const std::string& key) {
+	auto it = user_options.find(key);
+	std::string parsed = (it != user_options.end()) ? it->second : tree.get<std::string>(key);
+	std::vector<std::string> values;
+	if (parsed.empty()) return values;
+	boost::split(values, parsed, boost::is_any_of(":"));
+	return values;
+}
+
 Config::Config(const std::string& root, const std::unordered_map<std::string, std::string>& user_options, const std::string& filename)
 	: _user_options(user_options)
 {
@@ -67,7 +98,21 @@ void Config::load(const std::string& filename) {
 	
 	_delayed = parseOption<bool>(_root, _user_options, "delayed_evaluation", {{"true", true}, {"false", false}});
 	
-	_heuristic = parseOption<std::string>(_root, _user_options, "heuristic", {{"hff", "hff"}, {"hmax", "hmax"}});
+	_incremental_applicability = parseOption<bool>(_root, _user_options, "incremental_applicability", {{"true", true}, {"false", false}});
+	
+	_grounding_threads = parseNumericOption<unsigned>(_root, _user_options, "grounding_threads");
+	
+	_reachability_grounding = parseOption<bool>(_root, _user_options, "grounding", {{"full", false}, {"reachability", true}});
+	
+	_grounding_cache = parseStringOption(_root, _user_options, "grounding_cache");
+	
+	_search_threads = parseNumericOption<unsigned>(_root, _user_options, "search_threads");
+	
+	_portfolio = parseListOption(_root, _user_options, "portfolio");
+	
+	_heuristic_cache_size = parseNumericOption<unsigned>(_root, _user_options, "heuristic_cache");
+	
+	_heuristic = parseOption<std::string>(_root, _user_options, "heuristic", {{"hff", "hff"}, {"hmax", "hmax"}, {"hadd", "hadd"}});
 }
 
 
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <boost/property_tree/ptree.hpp>
 
 namespace fs0 {
@@ -56,6 +57,20 @@ protected:
 	
 	bool _delayed;
 	
+	bool _incremental_applicability;
+	
+	unsigned _grounding_threads;
+	
+	bool _reachability_grounding;
+	
+	std::string _grounding_cache;
+	
+	unsigned _search_threads;
+	
+	std::vector<std::string> _portfolio;
+	
+	unsigned _heuristic_cache_size;
+	
 	std::string _heuristic;
 	
 	//! Private constructor
@@ -87,6 +102,26 @@ public:
 	
 	bool useDelayedEvaluation() const { return _delayed; }
 	
+	bool useIncrementalApplicability() const { return _incremental_applicability; }
+	
+	//! The number of threads used to ground the action schemata, where 0 stands for the number of hardware threads
+	unsigned getGroundingThreads() const { return _grounding_threads; }
+	
+	//! Whether actions are grounded by relaxed reachability analysis instead of by enumerating all parameter bindings
+	bool useReachabilityGrounding() const { return _reachability_grounding; }
+	
+	//! The directory where grounded actions are cached across runs on the same instance, or empty if the cache is disabled
+	const std::string& getGroundingCache() const { return _grounding_cache; }
+	
+	//! The number of worker threads used by the parallel search drivers, where 0 stands for the number of hardware threads
+	unsigned getSearchThreads() const { return _search_threads; }
+	
+	//! The tags of the drivers that are run concurrently by the portfolio driver
+	const std::vector<std::string>& getPortfolio() const { return _portfolio; }
+	
+	//! The maximum number of heuristic values cached by the search drivers that support it, where 0 disables the cache
+	unsigned getHeuristicCacheSize() const { return _heuristic_cache_size; }
+	
 	const std::string& getHeuristic() const { return _heuristic; }
 	
 	bool useApproximateActionResolution() const {
@@ -70,6 +70,7 @@ const ProblemInfo&
 Loader::loadProblemInfo(const rapidjson::Document& data, const std::string& data_dir, const BaseComponentFactory& factory) {
 	// Load and set the ProblemInfo data structure
 	auto info = std::unique_ptr<ProblemInfo>(new ProblemInfo(data));
+	info->setDataDir(data_dir);
 	loadFunctions(factory, data_dir, *info);
 	ProblemInfo::setInstance(std::move(info));
 	return ProblemInfo::getInstance();
@@ -0,0 +1,29 @@
+
+#include <dlfcn.h>
+#include <stdexcept>
+
+#include <utils/plugin.hxx>
+#include <aptk2/tools/logging.hxx>
+
+namespace fs0 {
+
+const char* ProblemPlugin::GENERATOR_SYMBOL = "fs_generate_problem";
+
+std::string ProblemPlugin::_loaded_path;
+
+ProblemPlugin::ProblemPlugin(const std::string& path) :
+	_handle(dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL)), _generator(nullptr)
+{
+	if (!_handle) throw std::runtime_error("Could not load problem plugin '" + path + "': " + dlerror());
+
+	dlerror(); // Clear any previous error
+	void* symbol = dlsym(_handle, GENERATOR_SYMBOL);
+	const char* error = dlerror();
+	if (error || !symbol) throw std::runtime_error("Problem plugin '" + path + "' does not export '" + GENERATOR_SYMBOL + "'");
+
+	_generator = reinterpret_cast<GeneratorFunction>(symbol);
+	_loaded_path = path;
+	LPT_INFO("main", "Loaded problem plugin '" << path << "'");
+}
+
+} // namespaces
@@ -0,0 +1,42 @@
+
+#pragma once
+
+#include <string>
+#include <lib/rapidjson/document.h>
+
+namespace fs0 { class Problem; }
+
+namespace fs0 {
+
+//! A shared object with the instance-specific components of a problem, i.e. the implementation of its externally-defined
+//! symbols, which is loaded at runtime by the generic planner so that no per-instance planner binary needs to be compiled.
+//! The shared object must export the function that generates the problem under the C-linkage name given by GENERATOR_SYMBOL.
+class ProblemPlugin {
+public:
+	typedef Problem* (*GeneratorFunction)(const rapidjson::Document& data, const std::string& data_dir);
+
+	static const char* GENERATOR_SYMBOL;
+
+	//! Loads the shared object at the given path, throwing if it cannot be loaded or does not export the generator function
+	ProblemPlugin(const std::string& path);
+
+	//! The shared object is never unloaded, since the problem it generates keeps objects whose code lives in it
+	~ProblemPlugin() = default;
+
+	ProblemPlugin(const ProblemPlugin&) = delete;
+	ProblemPlugin& operator=(const ProblemPlugin&) = delete;
+
+	GeneratorFunction getGenerator() const { return _generator; }
+
+	//! The path of the plugin loaded in this process, if any, or an empty string otherwise
+	static const std::string& getLoadedPath() { return _loaded_path; }
+
+protected:
+	void* _handle;
+
+	GeneratorFunction _generator;
+
+	static std::string _loaded_path;
+};
+
+} // namespaces
@@ -1,6 +1,12 @@
 
+#include <algorithm>
 #include <string>
 #include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <utils/serializer.hxx>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -49,10 +55,66 @@ void Serializer::deserialize(const std::string& filename, DataInserter& inserter
 	}
 }
 
+void Serializer::deserialize(const std::string& filename, unsigned width, RowInserter& inserter, uint32_t tag) {
+	if (!boost::algorithm::ends_with(filename, ".bin")) {
+		std::ifstream is(filename);
+		std::string line;
+		while (std::getline(is, line)) {
+			std::vector<int> row = deserializeLine(line);
+			if (row.size() != width) throw std::runtime_error("Wrong number of elements in a line of data file " + filename);
+			inserter(row.data());
+		}
+		return;
+	}
+	
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("Could not open data file " + filename);
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (std::size_t) st.st_size < sizeof(BinaryHeader)) {
+		close(fd);
+		throw std::runtime_error("Truncated binary data file " + filename);
+	}
+	std::size_t size = st.st_size;
+	void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED) throw std::runtime_error("Could not map data file " + filename);
+	madvise(address, size, MADV_SEQUENTIAL);
+	
+	const BinaryHeader* header = static_cast<const BinaryHeader*>(address);
+	std::string error;
+	if (header->magic != BINARY_MAGIC) error = "Unrecognized binary data file ";
+	else if (header->version != BINARY_VERSION) error = "Unsupported version of binary data file ";
+	else if (header->tag != tag) error = "Unexpected contents in binary data file ";
+	else if (header->width != width) error = "Wrong row width in binary data file ";
+	else if (header->rows > (size - sizeof(BinaryHeader)) / (sizeof(int32_t) * std::max(width, 1u))) error = "Truncated binary data file ";
+	
+	if (error.empty()) {
+		const int32_t* row = reinterpret_cast<const int32_t*>(header + 1);
+		try {
+			for (uint64_t i = 0; i < header->rows; ++i, row += width) inserter(row);
+		} catch (...) {
+			munmap(address, size);
+			throw;
+		}
+	}
+	munmap(address, size);
+	if (!error.empty()) throw std::runtime_error(error + filename);
+}
+
+void Serializer::serializeBinary(const std::string& filename, unsigned width, const std::vector<int>& values, uint32_t tag) {
+	assert(width > 0 && values.size() % width == 0);
+	BinaryHeader header{BINARY_MAGIC, BINARY_VERSION, width, tag, values.size() / width};
+	std::ofstream os(filename, std::ios::binary);
+	os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+	os.close();
+	if (!os) throw std::runtime_error("Could not write binary data file " + filename);
+}
+
 int Serializer::deserialize0AryElement(const std::string& filename) {
 	int data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 1); data = elems[0]; };
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data = row[0]; };
+	deserialize(filename, 1, inserter);
 	return data;
 }
 
@@ -63,58 +125,61 @@ std::ostream& Serializer::serialize(std::ostream& os, const Serializer::UnaryMap
 	return os;
 }
 
+// Rows are appended with a hint at the end of the container, which takes constant amortized time when they come
+// sorted, as in binary data files, and falls back to a regular insertion otherwise.
+
 Serializer::BoostUnaryMap Serializer::deserializeUnaryMap(const std::string& filename) {
 	BoostUnaryMap data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 2); data.insert(std::make_pair(elems[0], elems[1])); };
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_pair(row[0], row[1])); };
+	deserialize(filename, 2, inserter);
 	return data;
 }
 
 Serializer::BoostBinaryMap Serializer::deserializeBinaryMap(const std::string& filename) {
 	BoostBinaryMap data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 3); data.insert(std::make_pair(std::make_pair(elems[0], elems[1]), elems[2]));};
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_pair(std::make_pair(row[0], row[1]), row[2])); };
+	deserialize(filename, 3, inserter);
 	return data;
 }
 
 Serializer::BoostArity3Map Serializer::deserializeArity3Map(const std::string& filename) {
 	BoostArity3Map data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 4); data.insert(std::make_pair(std::make_tuple(elems[0], elems[1], elems[2]), elems[3]));};
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_pair(std::make_tuple(row[0], row[1], row[2]), row[3])); };
+	deserialize(filename, 4, inserter);
 	return data;	
 }
 Serializer::BoostArity4Map Serializer::deserializeArity4Map(const std::string& filename) {
 	BoostArity4Map data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 5); data.insert(std::make_pair(std::make_tuple(elems[0], elems[1], elems[2], elems[3]), elems[4]));};
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_pair(std::make_tuple(row[0], row[1], row[2], row[3]), row[4])); };
+	deserialize(filename, 5, inserter);
 	return data;
 }
 
 Serializer::BoostUnarySet Serializer::deserializeUnarySet(const std::string& filename) {
 	BoostUnarySet data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 1); data.insert(elems[0]);};
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), row[0]); };
+	deserialize(filename, 1, inserter);
 	return data;
 }
 
 Serializer::BoostBinarySet Serializer::deserializeBinarySet(const std::string& filename) {
 	BoostBinarySet data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 2); data.insert(std::make_pair(elems[0], elems[1])); };
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_pair(row[0], row[1])); };
+	deserialize(filename, 2, inserter);
 	return data;
 }
 
 Serializer::BoostArity3Set Serializer::deserializeArity3Set(const std::string& filename) {
 	BoostArity3Set data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 3); data.insert(std::make_tuple(elems[0], elems[1], elems[2])); };
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_tuple(row[0], row[1], row[2])); };
+	deserialize(filename, 3, inserter);
 	return data;
 }
 
 Serializer::BoostArity4Set Serializer::deserializeArity4Set(const std::string& filename) {
 	BoostArity4Set data;
-	DataInserter inserter = [&data](const std::vector<int>& elems) { assert(elems.size() == 4); data.insert(std::make_tuple(elems[0], elems[1], elems[2], elems[3])); };
-	deserialize(filename, inserter);
+	RowInserter inserter = [&data](const int* row) { data.insert(data.end(), std::make_tuple(row[0], row[1], row[2], row[3])); };
+	deserialize(filename, 4, inserter);
 	return data;
 }
 
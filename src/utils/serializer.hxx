@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 #include <vector>
 #include <set>
@@ -63,6 +64,30 @@ public:
 	typedef std::function<void (const std::vector<int>&)> DataInserter;
 	static void deserialize(const std::string& filename, DataInserter& inserter);
 	
+	//! The header of a binary data file, which is followed by 'rows * width' 32-bit integers, all in little-endian order.
+	//! The rows of static extensions are sorted lexicographically and contain no duplicates, so that they can be appended
+	//! in order to the flat containers above, without any parsing nor reordering.
+	struct BinaryHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t width;
+		uint32_t tag; // An application-defined tag identifying the kind of contents, 0 for static extensions
+		uint64_t rows;
+	};
+	
+	static const uint32_t BINARY_MAGIC = 0x42445346; // "FSDB"
+	static const uint32_t BINARY_VERSION = 1;
+	
+	typedef std::function<void (const int*)> RowInserter;
+	
+	//! Reads all rows of the given width from the given file, which is memory-mapped and read in place if its name
+	//! ends in '.bin', and otherwise parsed as text, one comma-separated row per line.
+	//! Binary files whose header does not carry the given tag are rejected.
+	static void deserialize(const std::string& filename, unsigned width, RowInserter& inserter, uint32_t tag = 0);
+	
+	//! Writes the given rows of the given width, laid out contiguously in 'values', as a binary data file with the given tag
+	static void serializeBinary(const std::string& filename, unsigned width, const std::vector<int>& values, uint32_t tag = 0);
+	
 	//! Boost (de)serialization
 	template <typename T>
 	static void BoostDeserialize(const std::string& filename, T& data);
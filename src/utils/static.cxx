@@ -2,8 +2,49 @@
 #include <utils/static.hxx>
 #include <problem_info.hxx>
 
+#include <fstream>
+#include <limits>
+
 namespace fs0 {
 
+const std::size_t DenseExtension::NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+std::unique_ptr<DenseExtension>
+DenseExtension::build(const std::vector<ValueTuple>& tuples, unsigned arity, bool predicate) {
+	if (arity > MAX_ARITY) return nullptr;
+	std::unique_ptr<DenseExtension> table(new DenseExtension(arity, predicate));
+	
+	// Compute the range of objects of each argument position
+	for (unsigned i = 0; i < arity; ++i) {
+		long min = std::numeric_limits<long>::max(), max = std::numeric_limits<long>::min();
+		for (const ValueTuple& tuple:tuples) {
+			assert(tuple.size() == arity + 1);
+			min = std::min(min, static_cast<long>(tuple[i]));
+			max = std::max(max, static_cast<long>(tuple[i]));
+		}
+		table->_min[i] = tuples.empty() ? 0 : min;
+		table->_extent[i] = tuples.empty() ? 0 : static_cast<std::size_t>(max - min + 1);
+	}
+	
+	// The last argument position is the one that varies faster
+	std::size_t size = 1;
+	for (int i = arity - 1; i >= 0; --i) {
+		table->_stride[i] = size;
+		if (table->_extent[i] > 0 && size > MAX_SIZE / table->_extent[i]) return nullptr;
+		size *= table->_extent[i];
+	}
+	
+	table->_defined.resize(size, false);
+	if (!predicate) table->_values.resize(size, 0);
+	for (const ValueTuple& tuple:tuples) {
+		std::size_t idx = table->index(tuple.data());
+		assert(idx != NO_INDEX);
+		table->_defined[idx] = true;
+		if (!predicate) table->_values[idx] = tuple[arity];
+	}
+	return table;
+}
+
 
 std::unique_ptr<StaticExtension>
 StaticExtension::load_static_extension(const std::string& name, const std::string& data_dir, const ProblemInfo& info) {
@@ -13,7 +54,9 @@ StaticExtension::load_static_extension(const std::string& name, const std::strin
 	SymbolData::Type type = data.getType();
 	assert(type == SymbolData::Type::PREDICATE || type == SymbolData::Type::FUNCTION);
 	
-	std::string filename = data_dir + "/" + name + ".data"; 
+	// Prefer the binary version of the data, if the preprocessor generated it
+	std::string filename = data_dir + "/" + name + ".bin";
+	if (!std::ifstream(filename).good()) filename = data_dir + "/" + name + ".data";
 	StaticExtension* extension = nullptr;
 	
 	if (arity == 0) {
@@ -32,8 +75,8 @@ StaticExtension::load_static_extension(const std::string& name, const std::strin
 		else extension = new Arity3Function(Serializer::deserializeArity3Map(filename));
 		
 	} else if (arity == 4) {
-		if (type == SymbolData::Type::PREDICATE) extension = new Arity4Function(Serializer::deserializeArity4Map(filename));
-		else extension = new Arity4Predicate(Serializer::deserializeArity4Set(filename));
+		if (type == SymbolData::Type::PREDICATE) extension = new Arity4Predicate(Serializer::deserializeArity4Set(filename));
+		else extension = new Arity4Function(Serializer::deserializeArity4Map(filename));
 
 
 	} else WORK_IN_PROGRESS("Such high symbol arities have not yet been implemented");
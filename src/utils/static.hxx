@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <memory>
+#include <stdexcept>
+
 #include <fs_types.hxx>
 #include <utils/serializer.hxx>
 
@@ -8,10 +11,83 @@ namespace fs0 {
 
 class ProblemInfo;
 
+//! A dense lookup table for the extension of a static symbol of bounded arity. Each argument position ranges over the
+//! interval of objects that appear in that position in the extension, so that the value of the symbol on a given tuple of
+//! arguments is found by direct indexing instead of by a (logarithmic) search on a map. Predicates are stored as a bitset;
+//! functions as a multi-dimensional array of values plus a bitset marking the tuples on which the function is defined.
+class DenseExtension {
+public:
+	//! The maximum arity of the symbols that can be stored in a dense table
+	static const unsigned MAX_ARITY = 4;
+	
+	//! The maximum number of entries that we are willing to allocate for a single table
+	static const std::size_t MAX_SIZE = 1 << 24;
+	
+	static const std::size_t NO_INDEX;
+	
+	//! Builds the dense table corresponding to the given extension tuples (see StaticExtension::get_tuples), or returns
+	//! a null pointer if the symbol arity is too high or the resulting table would be too large.
+	static std::unique_ptr<DenseExtension> build(const std::vector<ValueTuple>& tuples, unsigned arity, bool predicate);
+	
+	unsigned arity() const { return _arity; }
+	
+	//! Returns the position in the table of the given arity-sized array of arguments, or NO_INDEX if out of the table bounds
+	std::size_t index(const ObjectIdx* arguments) const {
+		std::size_t idx = 0;
+		for (unsigned i = 0; i < _arity; ++i) {
+			std::size_t offset = static_cast<std::size_t>(static_cast<long>(arguments[i]) - _min[i]);
+			if (offset >= _extent[i]) return NO_INDEX;
+			idx += offset * _stride[i];
+		}
+		return idx;
+	}
+	
+	//! Returns the value of the symbol on the given arity-sized array of arguments. Predicates are false on any tuple not
+	//! in the extension; evaluating functions on a tuple where they are undefined throws, as the map-based extensions do.
+	ObjectIdx value(const ObjectIdx* arguments) const {
+		std::size_t idx = index(arguments);
+		bool defined = (idx != NO_INDEX) && _defined[idx];
+		if (_predicate) return defined;
+		if (!defined) throw std::out_of_range("Static function evaluated on a tuple outside its domain");
+		return _values[idx];
+	}
+	
+	ObjectIdx value(ObjectIdx o1) const { assert(_arity == 1); return value(&o1); }
+	ObjectIdx value(ObjectIdx o1, ObjectIdx o2) const { ObjectIdx arguments[] = {o1, o2}; assert(_arity == 2); return value(arguments); }
+
+protected:
+	DenseExtension(unsigned arity, bool predicate) : _arity(arity), _predicate(predicate), _min(), _extent(), _stride(), _defined(), _values() {}
+	
+	unsigned _arity;
+	
+	bool _predicate;
+	
+	//! The lowest object, the number of objects, and the stride of each argument position
+	long _min[MAX_ARITY];
+	std::size_t _extent[MAX_ARITY];
+	std::size_t _stride[MAX_ARITY];
+	
+	//! Whether each tuple belongs to the extension of the predicate / to the domain of the function
+	std::vector<bool> _defined;
+	
+	//! The value of the function on each tuple; empty for predicates
+	std::vector<ObjectIdx> _values;
+};
+
+
 class StaticExtension {
 public:
+	virtual ~StaticExtension() = default;
+	
 	virtual Function get_function() const = 0;
 	
+	//! Returns the extension as a list of tuples: for predicates, the tuples of objects for which the predicate holds,
+	//! each extended with the value 1 (i.e. 'true'); for functions, each tuple of arguments extended with the value of the function.
+	virtual std::vector<ValueTuple> get_tuples() const = 0;
+	
+	//! Returns the number of tuples of the extension, without building them
+	virtual std::size_t size() const = 0;
+	
 	//! Factory method
 	static std::unique_ptr<StaticExtension> load_static_extension(const std::string& name, const std::string& data_dir, const ProblemInfo& info);
 };
@@ -31,6 +107,10 @@ public:
 			return data;
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override { return {{_data}}; }
+	
+	std::size_t size() const override { return 1; }
 };
 
 class UnaryFunction : public StaticExtension {
@@ -47,6 +127,14 @@ public:
 			return data.at(parameters[0]);
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({elem.first, elem.second});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 class UnaryPredicate : public StaticExtension {
@@ -63,6 +151,14 @@ public:
 			return data.find(parameters[0]) != data.end();
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({elem, 1});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 
@@ -82,6 +178,14 @@ public:
 	}
 	
 	const Serializer::BoostBinaryMap& get_data() const { return _data; }
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({elem.first.first, elem.first.second, elem.second});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 class BinaryPredicate : public StaticExtension {
@@ -98,6 +202,14 @@ public:
 			return data.find({parameters[0], parameters[1]}) != data.end();
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({elem.first, elem.second, 1});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 class Arity3Function : public StaticExtension {
@@ -114,6 +226,14 @@ public:
 			return data.at(std::make_tuple(parameters[0], parameters[1], parameters[2]));
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({std::get<0>(elem.first), std::get<1>(elem.first), std::get<2>(elem.first), elem.second});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 class Arity3Predicate : public StaticExtension {
@@ -130,6 +250,14 @@ public:
 			return data.find(std::make_tuple(parameters[0], parameters[1], parameters[2])) != data.end();
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({std::get<0>(elem), std::get<1>(elem), std::get<2>(elem), 1});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 class Arity4Function : public StaticExtension {
@@ -146,6 +274,14 @@ public:
 			return data.at(std::make_tuple(parameters[0], parameters[1], parameters[2], parameters[3]));
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({std::get<0>(elem.first), std::get<1>(elem.first), std::get<2>(elem.first), std::get<3>(elem.first), elem.second});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 class Arity4Predicate : public StaticExtension {
@@ -162,6 +298,14 @@ public:
 			return data.find(std::make_tuple(parameters[0], parameters[1], parameters[2], parameters[3])) != data.end();
 		};
 	}
+	
+	std::vector<ValueTuple> get_tuples() const override {
+		std::vector<ValueTuple> tuples;
+		for (const auto& elem:_data) tuples.push_back({std::get<0>(elem), std::get<1>(elem), std::get<2>(elem), std::get<3>(elem), 1});
+		return tuples;
+	}
+	
+	std::size_t size() const override { return _data.size(); }
 };
 
 
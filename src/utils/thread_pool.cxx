@@ -0,0 +1,84 @@
+
+#include <algorithm>
+
+#include <utils/thread_pool.hxx>
+
+namespace fs0 {
+
+ThreadPool::ThreadPool(unsigned num_workers) :
+	_threads(), _generation(0), _task(nullptr), _num_tasks(0), _next_task(0), _busy_workers(0), _error(), _stopping(false)
+{
+	if (num_workers == 0) num_workers = std::max(std::thread::hardware_concurrency(), 1u);
+	for (unsigned worker = 1; worker < num_workers; ++worker) {
+		_threads.push_back(std::thread(&ThreadPool::work, this, worker));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_start_cv.notify_all();
+	for (std::thread& thread:_threads) thread.join();
+}
+
+void ThreadPool::run(unsigned num_tasks, const Task& task) {
+	if (num_tasks == 0) return;
+	
+	// Not worth waking up the pool threads
+	if (_threads.empty() || num_tasks == 1) {
+		for (unsigned i = 0; i < num_tasks; ++i) task(0, i);
+		return;
+	}
+	
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = &task;
+		_num_tasks = num_tasks;
+		_next_task = 0;
+		_busy_workers = _threads.size();
+		_error = nullptr;
+		++_generation;
+	}
+	_start_cv.notify_all();
+	
+	process(0);
+	
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done_cv.wait(lock, [this]() { return _busy_workers == 0; });
+	_task = nullptr;
+	if (_error) std::rethrow_exception(_error);
+}
+
+void ThreadPool::work(unsigned worker) {
+	unsigned long last_generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_start_cv.wait(lock, [this, last_generation]() { return _stopping || _generation != last_generation; });
+			if (_stopping) return;
+			last_generation = _generation;
+		}
+		
+		process(worker);
+		
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_busy_workers == 0) _done_cv.notify_one();
+		}
+	}
+}
+
+void ThreadPool::process(unsigned worker) {
+	for (unsigned i = _next_task++; i < _num_tasks; i = _next_task++) {
+		try {
+			(*_task)(worker, i);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_error) _error = std::current_exception();
+		}
+	}
+}
+
+} // namespaces
@@ -0,0 +1,59 @@
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fs0 {
+
+//! A minimal pool of persistent worker threads that run batches of independent tasks. The thread that calls 'run'
+//! takes part in the work as worker 0, hence a pool of N workers spawns only N-1 threads. Each task receives the
+//! index of the worker running it, so that tasks can use per-worker resources (e.g. per-worker heuristic instances).
+class ThreadPool {
+public:
+	typedef std::function<void(unsigned worker, unsigned task)> Task;
+	
+	//! A pool with the given number of workers, where 0 stands for the number of hardware threads
+	ThreadPool(unsigned num_workers);
+	~ThreadPool();
+	
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	
+	//! The number of workers of the pool, including the calling thread
+	unsigned size() const { return _threads.size() + 1; }
+	
+	//! Runs 'task(w, i)' for every i in [0, num_tasks), where w is the worker that runs each task, and returns once all tasks
+	//! are done. Tasks are dynamically distributed among workers. The first exception thrown by any task is rethrown here.
+	void run(unsigned num_tasks, const Task& task);
+
+protected:
+	std::vector<std::thread> _threads;
+	
+	std::mutex _mutex;
+	std::condition_variable _start_cv;
+	std::condition_variable _done_cv;
+	
+	//! The batch currently being run, identified by a generation counter
+	unsigned long _generation;
+	const Task* _task;
+	unsigned _num_tasks;
+	std::atomic<unsigned> _next_task;
+	unsigned _busy_workers;
+	std::exception_ptr _error;
+	
+	bool _stopping;
+	
+	//! The loop run by each of the pool threads
+	void work(unsigned worker);
+	
+	//! Runs tasks of the current batch until there are no more tasks left
+	void process(unsigned worker);
+};
+
+} // namespaces
@@ -0,0 +1,114 @@
+
+#include <random>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include <fixtures/problem_fixture.hxx>
+#include <constraints/direct/table_csp.hxx>
+#include <languages/fstrips/language.hxx>
+#include <utils/tuple_index.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! Checks that the native table CSPs of ground actions find exactly the solutions that satisfy the action precondition,
+//! on random RPG layers of the fixture problem
+class TableCSPTest : public fs0::test::ProblemFixture {
+protected:
+	static const fs::Term* var(VariableIdx variable) { return new fs::StateVariable(variable, nullptr); }
+	static const fs::Term* constant(int value) { return new fs::IntConstant(value); }
+
+	//! The solutions of the CSP on the given layer, each as the values of the CSP variables, in order
+	static std::set<std::vector<ObjectIdx>> solve(const DirectTableCSP& csp, const DirectTableCSP::LayerTest& in_layer) {
+		std::set<std::vector<ObjectIdx>> solutions;
+		csp.solve(in_layer, [&](const PartialAssignment& assignment) {
+			std::vector<ObjectIdx> solution;
+			for (VariableIdx variable:csp.getVariables()) solution.push_back(assignment.at(variable));
+			EXPECT_TRUE(solutions.insert(solution).second); // Every solution is found only once
+			return true;
+		});
+		return solutions;
+	}
+
+	//! The same solutions, computed by checking the precondition on every assignment of values of the layer
+	std::set<std::vector<ObjectIdx>> enumerate(const DirectTableCSP& csp, const fs::Formula* precondition, const TupleIndex& tuple_index, const DirectTableCSP::LayerTest& in_layer) {
+		std::vector<std::vector<ObjectIdx>> values;
+		for (VariableIdx variable:csp.getVariables()) {
+			values.push_back({});
+			for (ObjectIdx value:(info().isPredicativeVariable(variable) ? ObjectIdxVector{1} : info().getVariableObjects(variable))) {
+				if (in_layer(tuple_index.to_index(variable, value))) values.back().push_back(value);
+			}
+		}
+
+		std::set<std::vector<ObjectIdx>> solutions;
+		std::vector<ObjectIdx> solution(values.size());
+		std::function<void (unsigned)> extend = [&](unsigned depth) {
+			if (depth == values.size()) {
+				PartialAssignment assignment;
+				for (unsigned i = 0; i < depth; ++i) assignment[csp.getVariables()[i]] = solution[i];
+				if (precondition->interpret(assignment)) solutions.insert(solution);
+				return;
+			}
+			for (ObjectIdx value:values[depth]) {
+				solution[depth] = value;
+				extend(depth + 1);
+			}
+		};
+		extend(0);
+		return solutions;
+	}
+};
+
+TEST_F(TableCSPTest, SameSolutionsAsEnumeration) {
+	TupleIndex tuple_index(info());
+	// p(a) and f(a) != f(b) and n() < 5 and f(b) <= n(), with effect f(a) := f(c)
+	const fs::Formula* precondition = new fs::Conjunction({
+		new fs::EQAtomicFormula({var(0), constant(1)}),
+		new fs::NEQAtomicFormula({var(3), var(4)}),
+		new fs::LTAtomicFormula({var(6), constant(5)}),
+		new fs::LEQAtomicFormula({var(4), var(6)})
+	});
+	const fs::ActionEffect* effect = new fs::ActionEffect(var(3), var(5), new fs::Tautology);
+
+	std::unique_ptr<DirectTableCSP> csp = DirectTableCSP::create(precondition, {effect}, tuple_index, info());
+	ASSERT_TRUE(csp != nullptr);
+	EXPECT_EQ(csp->getVariables().size(), 5); // p(a), f(a), f(b), n() and f(c), which only appears in the effect
+
+	std::mt19937 generator;
+	unsigned nonempty = 0;
+	for (unsigned i = 0; i < 500; ++i) {
+		std::vector<bool> layer(tuple_index.size());
+		for (unsigned tuple = 0; tuple < layer.size(); ++tuple) layer[tuple] = generator() % 4 != 0;
+		DirectTableCSP::LayerTest in_layer = [&layer](TupleIdx tuple) { return layer[tuple]; };
+
+		auto expected = enumerate(*csp, precondition, tuple_index, in_layer);
+		ASSERT_EQ(solve(*csp, in_layer), expected) << "on layer #" << i;
+		nonempty += !expected.empty();
+	}
+	EXPECT_GT(nonempty, 0);
+	EXPECT_LT(nonempty, 500);
+
+	// The search stops as soon as the callback asks for it
+	unsigned found = 0;
+	csp->solve([](TupleIdx) { return true; }, [&found](const PartialAssignment&) { ++found; return false; });
+	EXPECT_EQ(found, 1);
+
+	delete effect;
+	delete precondition;
+}
+
+TEST_F(TableCSPTest, UnsupportedActions) {
+	TupleIndex tuple_index(info());
+	// A nested fluent, f(f(a)) = b
+	std::unique_ptr<const fs::Formula> nested(new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {var(3)}), constant(3)}));
+	EXPECT_TRUE(DirectTableCSP::create(nested.get(), {}, tuple_index, info()) == nullptr);
+
+	// A predicative variable in an atom other than p(x) = 1
+	std::unique_ptr<const fs::Formula> negated(new fs::NEQAtomicFormula({var(1), constant(1)}));
+	EXPECT_TRUE(DirectTableCSP::create(negated.get(), {}, tuple_index, info()) == nullptr);
+
+	// An unsatisfiable precondition
+	std::unique_ptr<const fs::Formula> unsatisfiable(new fs::Conjunction({new fs::LTAtomicFormula({var(6), var(6)})}));
+	EXPECT_TRUE(DirectTableCSP::create(unsatisfiable.get(), {}, tuple_index, info()) == nullptr);
+}
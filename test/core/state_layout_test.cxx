@@ -0,0 +1,68 @@
+
+#include <gtest/gtest.h>
+
+#include <fixtures/problem_fixture.hxx>
+#include <state_layout.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+
+using namespace fs0;
+
+class StateLayoutTest : public fs0::test::ProblemFixture {};
+
+// Each variable takes only as many bits as needed to encode its domain, plus the value 0 of unset variables
+TEST_F(StateLayoutTest, SlotWidths) {
+	const StateLayout& layout = info().getStateLayout();
+	ASSERT_EQ(layout.getNumVariables(), 7);
+	for (VariableIdx variable = 0; variable < 3; ++variable) EXPECT_EQ(layout.getWidth(variable), 1); // p(x)
+	for (VariableIdx variable = 3; variable < 6; ++variable) EXPECT_EQ(layout.getWidth(variable), 3); // f(x), objects 2 to 4
+	EXPECT_EQ(layout.getWidth(6), 5); // n(), from -3 to 20
+	EXPECT_EQ(layout.getNumBlocks(), 1);
+}
+
+// Encoding any value of the domain of a variable leaves the rest of variables untouched
+TEST_F(StateLayoutTest, SetAndGet) {
+	const StateLayout& layout = info().getStateLayout();
+	std::vector<StateLayout::BlockT> blocks(layout.getNumBlocks(), 0);
+	std::vector<ObjectIdx> expected{0, 1, 0, 2, 3, 4, -3};
+	for (VariableIdx variable = 0; variable < expected.size(); ++variable) layout.set(blocks.data(), variable, expected[variable]);
+
+	for (VariableIdx variable = 0; variable < expected.size(); ++variable) {
+		for (ObjectIdx value:info().getVariableObjects(variable)) {
+			layout.set(blocks.data(), variable, value);
+			EXPECT_EQ(layout.get(blocks.data(), variable), value);
+			for (VariableIdx other = 0; other < expected.size(); ++other) {
+				if (other != variable) EXPECT_EQ(layout.get(blocks.data(), other), expected[other]);
+			}
+		}
+		layout.set(blocks.data(), variable, expected[variable]);
+	}
+}
+
+// Values outside the domain of a variable are rejected instead of being written over the slots of other variables
+TEST_F(StateLayoutTest, OutOfRange) {
+	const StateLayout& layout = info().getStateLayout();
+	std::vector<StateLayout::BlockT> blocks(layout.getNumBlocks(), 0);
+	layout.set(blocks.data(), 5, 4);
+	layout.set(blocks.data(), 6, -3);
+	EXPECT_THROW(layout.set(blocks.data(), 6, -4), std::runtime_error);
+	EXPECT_THROW(layout.set(blocks.data(), 6, 21), std::runtime_error);
+	EXPECT_THROW(layout.set(blocks.data(), 5, 5), std::runtime_error);
+	EXPECT_THROW(layout.set(blocks.data(), 0, 2), std::runtime_error);
+	EXPECT_EQ(layout.get(blocks.data(), 5), 4);
+	EXPECT_EQ(layout.get(blocks.data(), 6), -3);
+}
+
+// The hash of a state updated incrementally equals that of the same state built from scratch
+TEST_F(StateLayoutTest, IncrementalHash) {
+	State initial(7, {Atom(1, 1), Atom(3, 4), Atom(6, -3)});
+	State updated(initial, {Atom(1, 0), Atom(0, 1), Atom(6, 20), Atom(5, 3)});
+	State scratch(7, {Atom(0, 1), Atom(3, 4), Atom(5, 3), Atom(6, 20)});
+	EXPECT_EQ(updated, scratch);
+	EXPECT_EQ(updated.hash(), scratch.hash());
+	EXPECT_EQ(updated.getValue(6), 20);
+
+	State reverted(updated, {Atom(1, 1), Atom(0, 0), Atom(6, -3), Atom(5, 0)});
+	EXPECT_EQ(reverted, initial);
+	EXPECT_EQ(reverted.hash(), initial.hash());
+}
@@ -0,0 +1,51 @@
+
+#include <gtest/gtest.h>
+
+#include <fixtures/problem_fixture.hxx>
+#include <state_registry.hxx>
+#include <atom.hxx>
+
+using namespace fs0;
+
+class StateRegistryTest : public fs0::test::ProblemFixture {
+protected:
+	virtual void SetUp() { StateRegistry::instance().clear(); }
+	virtual void TearDown() { StateRegistry::instance().clear(); }
+
+	static State make(ObjectIdx n) { return State(7, {Atom(3, 2), Atom(6, n)}); }
+};
+
+// Equal states are registered only once
+TEST_F(StateRegistryTest, Interning) {
+	StateRegistry& registry = StateRegistry::instance();
+	StateIdx first = registry.intern(make(1)), second = registry.intern(make(2));
+	EXPECT_NE(first, second);
+	EXPECT_EQ(registry.intern(make(1)), first);
+	EXPECT_EQ(registry.size(), 2);
+	EXPECT_EQ(registry.find(make(2)), second);
+	EXPECT_EQ(registry.find(make(3)), INVALID_STATE);
+	EXPECT_EQ(StateRef(second).get(), make(2));
+}
+
+// Only the most recently registered state can be released, and only if nobody else interned it
+TEST_F(StateRegistryTest, Release) {
+	StateRegistry& registry = StateRegistry::instance();
+	StateIdx kept = registry.intern(make(1));
+	StateIdx pruned = registry.intern(make(2));
+	EXPECT_FALSE(registry.release(kept));
+	EXPECT_TRUE(registry.release(pruned));
+	EXPECT_EQ(registry.size(), 1);
+	EXPECT_EQ(registry.find(make(2)), INVALID_STATE);
+	EXPECT_FALSE(registry.release(kept)); // The state was registered before the released one, and might be shared
+
+	StateIdx shared = registry.intern(make(3));
+	EXPECT_EQ(registry.intern(make(3)), shared);
+	EXPECT_FALSE(registry.release(shared));
+	EXPECT_EQ(registry.get(shared), make(3));
+
+	// Released indexes are reused by the next registered state
+	StateIdx next = registry.intern(make(4));
+	EXPECT_TRUE(registry.release(next));
+	EXPECT_EQ(registry.intern(make(5)), next);
+	EXPECT_EQ(registry.get(next), make(5));
+}
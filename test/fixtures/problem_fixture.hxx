@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+
+#include "fixtures/base_fixture.hxx"
+#include <lib/rapidjson/document.h>
+#include <problem_info.hxx>
+#include <utils/static.hxx>
+
+namespace fs0 { namespace test {
+
+//! A fixture that sets up the problem info of a small problem with predicative variables p(a), p(b), p(c),
+//! object-valued variables f(a), f(b), f(c), with domain {a, b, c}, an integer variable n() in [-3, 20], and a static
+//! function g over {a, b, c} such that g(a) = b, g(b) = c and g(c) = a.
+//! The problem info is a global singleton, hence it is loaded only once and shared by all tests.
+class ProblemFixture : public BaseFixture {
+protected:
+	static void SetUpTestCase() {
+		static bool loaded = false;
+		if (loaded) return;
+		rapidjson::Document data;
+		data.Parse(PROBLEM);
+		assert(!data.HasParseError());
+		std::unique_ptr<ProblemInfo> info(new ProblemInfo(data));
+		Serializer::BoostUnaryMap g;
+		g[2] = 3; g[3] = 4; g[4] = 2;
+		info->set_extension(3, std::unique_ptr<StaticExtension>(new UnaryFunction(std::move(g))));
+		ProblemInfo::setInstance(std::move(info));
+		loaded = true;
+	}
+
+	const ProblemInfo& info() const { return ProblemInfo::getInstance(); }
+
+	static constexpr const char* PROBLEM = R"json({
+		"types": [[0, "bool", ["0", "1"]], [1, "obj", ["2", "3", "4"]], [2, "num", "int", [-3, 20]]],
+		"objects": [{"id": 0, "name": "false"}, {"id": 1, "name": "true"}, {"id": 2, "name": "a"}, {"id": 3, "name": "b"}, {"id": 4, "name": "c"}],
+		"symbols": [[0, "p", "predicate", ["obj"], "bool", [[0], [1], [2]], false],
+		            [1, "f", "function", ["obj"], "obj", [[3], [4], [5]], false],
+		            [2, "n", "function", [], "num", [[6]], false],
+		            [3, "g", "function", ["obj"], "obj", [], true]],
+		"variables": [{"id": 0, "name": "p(a)", "type": "bool", "data": [0, [2]]}, {"id": 1, "name": "p(b)", "type": "bool", "data": [0, [3]]},
+		              {"id": 2, "name": "p(c)", "type": "bool", "data": [0, [4]]}, {"id": 3, "name": "f(a)", "type": "obj", "data": [1, [2]]},
+		              {"id": 4, "name": "f(b)", "type": "obj", "data": [1, [3]]}, {"id": 5, "name": "f(c)", "type": "obj", "data": [1, [4]]},
+		              {"id": 6, "name": "n()", "type": "num", "data": [2, []]}],
+		"problem": {"domain": "test", "instance": "test"}
+	})json";
+};
+
+} } // namespaces
@@ -0,0 +1,77 @@
+
+#include <random>
+#include <set>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <heuristics/novelty/bit_novelty_tables.hxx>
+
+using namespace fs0;
+
+class BitNoveltyTablesTest : public testing::Test {
+protected:
+	//! The novelty of a valuation according to explicit sets of the (feature, value) pairs and tuples seen so far
+	unsigned reference_novelty(const std::vector<int>& values, unsigned max_novelty) {
+		bool new_atom = false, new_pair = false;
+		for (unsigned f = 0; f < values.size(); ++f) {
+			new_atom = _atoms.insert(std::make_pair(f, values[f])).second || new_atom;
+			for (unsigned g = f + 1; g < values.size(); ++g) {
+				new_pair = _pairs.insert(std::make_tuple(f, values[f], g, values[g])).second || new_pair;
+			}
+		}
+		if (new_atom) return 1;
+		if (max_novelty > 1 && new_pair) return 2;
+		return max_novelty + 1;
+	}
+
+	//! Checks the tables against the reference on random valuations of the given features
+	void check_random_valuations(const std::vector<std::pair<int, int>>& bounds, unsigned max_novelty, unsigned num_valuations) {
+		ASSERT_TRUE(BitNoveltyTables::is_applicable(bounds, max_novelty));
+		BitNoveltyTables tables(bounds, max_novelty);
+		std::mt19937 generator(1);
+		std::vector<int> values(bounds.size());
+		for (unsigned i = 0; i < num_valuations; ++i) {
+			for (unsigned f = 0; f < bounds.size(); ++f) {
+				values[f] = std::uniform_int_distribution<int>(bounds[f].first, bounds[f].second)(generator);
+			}
+			ASSERT_EQ(tables.evaluate(values), reference_novelty(values, max_novelty));
+		}
+	}
+
+	std::set<std::pair<unsigned, int>> _atoms;
+	std::set<std::tuple<unsigned, int, unsigned, int>> _pairs;
+};
+
+TEST_F(BitNoveltyTablesTest, Width1) {
+	BitNoveltyTables tables({{0, 1}, {-2, 2}}, 1);
+	EXPECT_EQ(tables.evaluate({0, 0}), 1);
+	EXPECT_EQ(tables.evaluate({0, 0}), 2);
+	EXPECT_EQ(tables.evaluate({1, 0}), 1);
+	EXPECT_EQ(tables.evaluate({0, -2}), 1);
+	EXPECT_EQ(tables.evaluate({1, -2}), 2); // A new pair, but the bound is 1
+
+	check_random_valuations({{0, 3}, {-2, 2}, {0, 70}, {5, 5}, {0, 1}}, 1, 5000);
+}
+
+TEST_F(BitNoveltyTablesTest, Width2) {
+	BitNoveltyTables tables({{0, 1}, {-2, 2}, {0, 1}}, 2);
+	EXPECT_EQ(tables.evaluate({0, 0, 0}), 1);
+	EXPECT_EQ(tables.evaluate({0, 0, 0}), 3);
+	EXPECT_EQ(tables.evaluate({1, 0, 1}), 1);
+	EXPECT_EQ(tables.evaluate({1, 0, 0}), 2);
+	EXPECT_EQ(tables.evaluate({0, 0, 1}), 2);
+	EXPECT_EQ(tables.evaluate({1, 0, 1}), 3);
+
+	// The rows of the pairs of the last features span several words
+	check_random_valuations({{0, 3}, {-2, 2}, {0, 70}, {5, 5}, {0, 1}, {0, 200}}, 2, 20000);
+}
+
+// The width-2 tables are only used when W^2/2 bits fit the memory budget
+TEST_F(BitNoveltyTablesTest, Applicability) {
+	std::vector<std::pair<int, int>> bounds{{0, 100000}};
+	EXPECT_TRUE(BitNoveltyTables::is_applicable(bounds, 1));
+	EXPECT_FALSE(BitNoveltyTables::is_applicable(bounds, 2));
+	EXPECT_FALSE(BitNoveltyTables::is_applicable(bounds, 3));
+	EXPECT_FALSE(BitNoveltyTables::is_applicable({{3, 2}}, 1));
+}
@@ -0,0 +1,99 @@
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <fixtures/problem_fixture.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <languages/fstrips/bytecode.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! Checks that compiled formulas and terms evaluate exactly as their interpretation, on random states of the fixture problem
+class BytecodeTest : public fs0::test::ProblemFixture {
+protected:
+	static const fs::Term* var(VariableIdx variable) { return new fs::StateVariable(variable, nullptr); }
+	static const fs::Term* constant(int value) { return new fs::IntConstant(value); }
+	static const fs::Term* f(const fs::Term* subterm) { return new fs::FluentHeadedNestedTerm(1, {subterm}); }
+	static const fs::Term* g(const fs::Term* subterm) { return new fs::UserDefinedStaticTerm(3, {subterm}); }
+
+	//! Returns a random state where all object-valued variables hold some object, so that f(f(x)) is always defined
+	State random_state() {
+		std::vector<Atom> atoms;
+		for (VariableIdx variable = 0; variable < 3; ++variable) atoms.push_back(Atom(variable, _generator() % 2));
+		for (VariableIdx variable = 3; variable < 6; ++variable) atoms.push_back(Atom(variable, 2 + _generator() % 3));
+		atoms.push_back(Atom(6, (int) (_generator() % 24) - 3));
+		return State(7, atoms);
+	}
+
+	std::mt19937 _generator;
+};
+
+TEST_F(BytecodeTest, Formulas) {
+	std::vector<const fs::Formula*> formulas = {
+		new fs::Tautology,
+		new fs::Contradiction,
+		new fs::EQAtomicFormula({var(0), constant(1)}),
+		new fs::NEQAtomicFormula({var(1), constant(0)}),
+		new fs::Conjunction({new fs::EQAtomicFormula({var(0), constant(1)}), new fs::NEQAtomicFormula({var(2), constant(1)})}),
+		new fs::LTAtomicFormula({new fs::AdditionTerm({var(6), constant(3)}), new fs::MultiplicationTerm({var(6), constant(2)})}),
+		new fs::GEQAtomicFormula({new fs::SubtractionTerm({var(6), constant(5)}), constant(0)}),
+		new fs::EQAtomicFormula({f(var(3)), constant(4)}),
+		new fs::EQAtomicFormula({g(var(4)), f(var(3))}),
+		new fs::Conjunction({new fs::LEQAtomicFormula({var(3), var(4)}), new fs::GTAtomicFormula({g(g(var(5))), var(3)})}),
+		new fs::NEQAtomicFormula({f(f(var(5))), g(var(5))}),
+	};
+
+	std::vector<fs::CompiledFormula> compiled(formulas.begin(), formulas.end());
+	for (const auto& formula:compiled) ASSERT_TRUE(formula.code().valid()) << *formula.formula();
+
+	for (unsigned i = 0; i < 5000; ++i) {
+		State state = random_state();
+		for (const auto& formula:compiled) {
+			ASSERT_EQ(formula.code().holds(state), formula.formula()->interpret(state)) << *formula.formula() << " on " << state;
+		}
+	}
+	for (const fs::Formula* formula:formulas) delete formula;
+}
+
+TEST_F(BytecodeTest, Terms) {
+	std::vector<const fs::Term*> terms = {
+		var(6),
+		g(var(3)),
+		f(var(3)),
+		f(g(f(var(4)))),
+		new fs::AdditionTerm({g(f(var(5))), new fs::MultiplicationTerm({var(6), var(6)})}),
+	};
+
+	for (unsigned i = 0; i < 5000; ++i) {
+		State state = random_state();
+		for (const fs::Term* term:terms) {
+			fs::Bytecode code = fs::Bytecode::compile_term(term);
+			ASSERT_TRUE(code.valid()) << *term;
+			ASSERT_EQ(code.evaluate(state), term->interpret(state)) << *term << " on " << state;
+		}
+	}
+
+	// Fluent-headed nested terms can also be compiled into the resolution of the state variable they denote
+	const fs::Term* nested = f(f(var(3)));
+	fs::Bytecode code = fs::Bytecode::compile_variable(nested);
+	ASSERT_TRUE(code.valid());
+	for (unsigned i = 0; i < 1000; ++i) {
+		State state = random_state();
+		ASSERT_EQ((VariableIdx) code.evaluate(state), nested->interpretVariable(state));
+	}
+
+	delete nested;
+	for (const fs::Term* term:terms) delete term;
+}
+
+// Formulas with quantified variables cannot be compiled, and are left to the interpreter
+TEST_F(BytecodeTest, Unsupported) {
+	const fs::Formula* formula = new fs::EQAtomicFormula({new fs::BoundVariable(0, 0), constant(1)});
+	EXPECT_FALSE(fs::Bytecode::compile_formula(formula).valid());
+	delete formula;
+}
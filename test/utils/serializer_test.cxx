@@ -0,0 +1,96 @@
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <utils/serializer.hxx>
+
+using namespace fs0;
+
+//! Checks that static extensions read from binary data files are the same as those read from the equivalent text files
+class SerializerTest : public testing::Test {
+protected:
+	virtual void SetUp() {
+		_base = std::string(P_tmpdir) + "/fs_serializer_test_" + std::to_string(getpid());
+	}
+
+	virtual void TearDown() {
+		for (const std::string& filename:_created) std::remove(filename.c_str());
+	}
+
+	std::string filename(const std::string& name) {
+		_created.push_back(_base + "_" + name);
+		return _created.back();
+	}
+
+	//! Writes the given rows as a text data file, one comma-separated row per line
+	static void write_text(const std::string& filename, unsigned width, const std::vector<int>& values) {
+		std::ofstream os(filename);
+		for (unsigned i = 0; i < values.size(); ++i) os << values[i] << ((i % width == width - 1) ? "\n" : ",");
+	}
+
+	std::string _base;
+	std::vector<std::string> _created;
+};
+
+TEST_F(SerializerTest, BinaryMatchesText) {
+	// A binary map with negative values and a row per line, sorted lexicographically, as the preprocessor outputs them
+	std::vector<int> values{0, 1, 5, 0, 2, -7, 1, 0, 3, 3, 3, 2147483647, 4, -1, -2147483647};
+	std::string text = filename("map.data"), binary = filename("map.bin");
+	write_text(text, 3, values);
+	Serializer::serializeBinary(binary, 3, values);
+
+	Serializer::BoostBinaryMap from_text = Serializer::deserializeBinaryMap(text);
+	Serializer::BoostBinaryMap from_binary = Serializer::deserializeBinaryMap(binary);
+	ASSERT_EQ(from_binary.size(), 5);
+	EXPECT_TRUE(from_text == from_binary);
+	EXPECT_EQ(from_binary.at(std::make_pair(0, 2)), -7);
+	EXPECT_EQ(from_binary.at(std::make_pair(4, -1)), -2147483647);
+
+	std::vector<int> rows;
+	Serializer::RowInserter inserter = [&rows](const int* row) { rows.insert(rows.end(), row, row + 3); };
+	Serializer::deserialize(binary, 3, inserter);
+	EXPECT_EQ(rows, values);
+}
+
+TEST_F(SerializerTest, SetsOfAllArities) {
+	std::vector<int> unary{-3, 0, 8}, arity3{0, 0, 1, 0, 1, 0, 2, 2, 2}, arity4{1, 2, 3, 4, 5, 6, 7, 8};
+	std::string unary_file = filename("unary.bin"), arity3_file = filename("arity3.bin"), arity4_file = filename("arity4.bin");
+	Serializer::serializeBinary(unary_file, 1, unary);
+	Serializer::serializeBinary(arity3_file, 3, arity3);
+	Serializer::serializeBinary(arity4_file, 4, arity4);
+
+	EXPECT_TRUE(Serializer::deserializeUnarySet(unary_file) == Serializer::BoostUnarySet({-3, 0, 8}));
+	Serializer::BoostArity3Set set3 = Serializer::deserializeArity3Set(arity3_file);
+	ASSERT_EQ(set3.size(), 3);
+	EXPECT_TRUE(set3.count(std::make_tuple(0, 1, 0)));
+	Serializer::BoostArity4Set set4 = Serializer::deserializeArity4Set(arity4_file);
+	ASSERT_EQ(set4.size(), 2);
+	EXPECT_TRUE(set4.count(std::make_tuple(5, 6, 7, 8)));
+}
+
+TEST_F(SerializerTest, RejectsInvalidFiles) {
+	std::vector<int> values{1, 2, 3, 4};
+	std::string binary = filename("pairs.bin");
+	Serializer::serializeBinary(binary, 2, values, 42);
+	Serializer::RowInserter ignore = [](const int*) {};
+
+	EXPECT_THROW(Serializer::deserialize(binary, 2, ignore), std::runtime_error); // Wrong tag
+	EXPECT_THROW(Serializer::deserialize(binary, 4, ignore, 42), std::runtime_error); // Wrong width
+	EXPECT_NO_THROW(Serializer::deserialize(binary, 2, ignore, 42));
+
+	// Drop the last integer of the file
+	std::ifstream is(binary, std::ios::binary);
+	std::string contents((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+	std::string truncated = filename("truncated.bin");
+	std::ofstream(truncated, std::ios::binary) << contents.substr(0, contents.size() - sizeof(int));
+	EXPECT_THROW(Serializer::deserialize(truncated, 2, ignore, 42), std::runtime_error);
+
+	// A text file is not a binary file, whatever its name
+	std::string text = filename("text.bin");
+	write_text(text, 2, values);
+	EXPECT_THROW(Serializer::deserialize(text, 2, ignore), std::runtime_error);
+}